@@ -0,0 +1,631 @@
+#define _POSIX_C_SOURCE 200809L //Necessário para dup/fdopen
+#include "emergencia.h"
+#include <unistd.h>
+
+//Micro-benchmarks de cada módulo de emergencia.c
+//Compile com "make bench" ou, à mão, duas vezes para comparar as tabelas de cidadãos:
+//  gcc -O2 -o bench_encadeada benchmark.c emergencia.c -std=c99 -lm
+//  gcc -O2 -DCIDADAOS_TABELA_PLANA -o bench_plana benchmark.c emergencia.c -std=c99 -lm
+//A árvore AVL e a fila de baldes são comparadas no mesmo executável
+//
+//Saída em CSV (modulo,backend,n,operacao,ns_por_op) na saída padrão; as mensagens
+//que o próprio sistema imprime durante as medições são descartadas
+//
+//"./benchmark arvores N M [arquivo.csv]" compara lista sequencial, BST e AVL (N = 0 roda a série até 10^7)
+//"./benchmark cidadaos [N...]" mede só a tabela de cidadãos (padrão 10^6 e 10^7), que é o módulo que chega a 10^7
+
+#ifdef CIDADAOS_TABELA_PLANA
+#define BACKEND_CIDADAOS "plana"
+#else
+#define BACKEND_CIDADAOS "encadeada"
+#endif
+
+#define SEMENTE_BENCHMARK 88172645463325252ULL //Semente fixa, reiniciada no começo de cada módulo
+#define N_AQUECIMENTO 10000 //Tamanho da rodada de aquecimento (resultados descartados)
+#define BAIRROS_BENCHMARK 100 //Bairros usados nos benchmarks do mapa e do sistema
+#define UNIDADES_BENCHMARK 30 //Unidades de cada serviço no benchmark do sistema
+#define CHEGADAS_POR_TICK 4 //Ocorrências novas por unidade de tempo no benchmark do sistema
+#define TEMPOS_SIMULACAO_BENCHMARK 43200 //Unidades de tempo simuladas no benchmark da simulação por eventos
+#define CONSULTAS_FROTA_BENCHMARK 1000 //Consultas de agregados (contagens da frota, percentis) medidas por benchmark
+#define RECLASSIFICACOES_BENCHMARK 1000 //Chamados reclassificados em cada grupo (recentes, sorteados, antigos) no benchmark de prioridades
+
+//Gerador pseudoaleatório com semente fixa, para execuções repetíveis
+uint64_t estado_aleatorio = SEMENTE_BENCHMARK;
+
+uint64_t proximo_aleatorio() {
+    return proximo_aleatorio_benchmark(&estado_aleatorio);
+}
+
+//Destino dos resultados (a saída padrão original) e chave da rodada de aquecimento
+FILE* saida = NULL;
+int aquecendo = 0;
+
+//Gera o CPF do i-ésimo cidadão sintético, espalhado pelo espaço de 11 dígitos
+//(multiplicar por um número primo com 10 é uma bijeção módulo 10^11, então não há repetição)
+void cpf_sintetico(long i, char* destino) {
+    formatar_cpf(((uint64_t)i * 2654435761ULL) % 100000000000ULL, destino);
+}
+
+//Mostra uma linha de resultado em CSV (nada durante o aquecimento)
+void reportar(const char* modulo, const char* backend, long n, const char* operacao, long operacoes, double segundos) {
+    if (aquecendo || operacoes <= 0) return;
+    
+    fprintf(saida, "%s,%s,%ld,%s,%.1f\n", modulo, backend, n, operacao, segundos * 1e9 / operacoes);
+    fflush(saida);
+}
+
+//Cria n ocorrências sintéticas com IDs 1..n em ordem aleatória
+Ocorrencia** criar_ocorrencias_sinteticas(long n) {
+    Ocorrencia** ocorrencias = (Ocorrencia**)malloc((size_t)n * sizeof(Ocorrencia*));
+    if (!ocorrencias) {
+        fprintf(stderr, "Memória insuficiente para %ld ocorrências\n", n);
+        return NULL;
+    }
+    
+    for (long i = 0; i < n; i++) {
+        ocorrencias[i] = criar_ocorrencia((int)i + 1, (int)(i % BAIRROS_BENCHMARK),
+                                          (TipoServico)(proximo_aleatorio() % NUM_TIPOS_SERVICO),
+                                          1 + (int)(proximo_aleatorio() % NIVEIS_GRAVIDADE), (int)i);
+    }
+    for (long i = n - 1; i > 0; i--) {
+        long j = (long)(proximo_aleatorio() % (uint64_t)(i + 1));
+        Ocorrencia* temp = ocorrencias[i];
+        ocorrencias[i] = ocorrencias[j];
+        ocorrencias[j] = temp;
+    }
+    
+    return ocorrencias;
+}
+
+// ==================== BAIRROS ====================
+
+//Mede inserção e busca (acerto e falha) com n bairros
+void benchmark_bairros(long n) {
+    estado_aleatorio = SEMENTE_BENCHMARK;
+    TabelaHashBairros* tabela = criar_tabela_bairros();
+    long soma = 0;
+    
+    double inicio = tempo_em_segundos();
+    for (long i = 0; i < n; i++) {
+        inserir_bairro(tabela, (int)i + 1, "Bairro");
+    }
+    reportar("bairros", "hash", n, "inserir", n, tempo_em_segundos() - inicio);
+    
+    inicio = tempo_em_segundos();
+    for (long i = 0; i < n; i++) {
+        Bairro* bairro = buscar_bairro(tabela, 1 + (int)(proximo_aleatorio() % n));
+        soma += bairro ? bairro->id : -1;
+    }
+    reportar("bairros", "hash", n, "buscar_existente", n, tempo_em_segundos() - inicio);
+    
+    inicio = tempo_em_segundos();
+    for (long i = 0; i < n; i++) {
+        soma += buscar_bairro(tabela, (int)(n + 1 + (long)(proximo_aleatorio() % n))) != NULL;
+    }
+    reportar("bairros", "hash", n, "buscar_inexistente", n, tempo_em_segundos() - inicio);
+    
+    //Confere o resultado para que o compilador não descarte as buscas
+    if (soma < 0) fprintf(stderr, "Busca falhou durante o benchmark\n");
+    
+    liberar_tabela_bairros(tabela);
+}
+
+// ==================== CIDADÃOS ====================
+
+//Mede inserção, busca (acerto e falha) e remoção com n cidadãos
+void benchmark_cidadaos(long n) {
+    estado_aleatorio = SEMENTE_BENCHMARK;
+    char (*cpfs)[MAX_CPF] = malloc((size_t)(2 * n) * sizeof(*cpfs));
+    if (!cpfs) {
+        fprintf(stderr, "Memória insuficiente para %ld CPFs\n", n);
+        return;
+    }
+    for (long i = 0; i < 2 * n; i++) {
+        cpf_sintetico(i + 1, cpfs[i]);
+    }
+    
+    TabelaHashCidadaos* tabela = criar_tabela_cidadaos();
+    long soma = 0;
+    
+    double inicio = tempo_em_segundos();
+    for (long i = 0; i < n; i++) {
+        inserir_cidadao(tabela, cpfs[i], "Cidadao", "email@exemplo.com", "Rua", (int)(i % 100));
+    }
+    reportar("cidadaos", BACKEND_CIDADAOS, n, "inserir", n, tempo_em_segundos() - inicio);
+    
+    inicio = tempo_em_segundos();
+    for (long i = 0; i < n; i++) {
+        Cidadao* cidadao = buscar_cidadao(tabela, cpfs[proximo_aleatorio() % n]);
+        soma += cidadao ? cidadao->bairro_id : -1;
+    }
+    reportar("cidadaos", BACKEND_CIDADAOS, n, "buscar_existente", n, tempo_em_segundos() - inicio);
+    
+    inicio = tempo_em_segundos();
+    for (long i = 0; i < n; i++) {
+        soma += buscar_cidadao(tabela, cpfs[n + (long)(proximo_aleatorio() % n)]) != NULL;
+    }
+    reportar("cidadaos", BACKEND_CIDADAOS, n, "buscar_inexistente", n, tempo_em_segundos() - inicio);
+    
+    inicio = tempo_em_segundos();
+    for (long i = 0; i < n; i += 2) {
+        remover_cidadao(tabela, cpfs[i]);
+    }
+    reportar("cidadaos", BACKEND_CIDADAOS, n, "remover", (n + 1) / 2, tempo_em_segundos() - inicio);
+    
+    //Confere o resultado para que o compilador não descarte as buscas
+    if (soma < 0) fprintf(stderr, "Busca falhou durante o benchmark\n");
+    
+    liberar_tabela_cidadaos(tabela);
+    free(cpfs);
+}
+
+// ==================== FILAS ====================
+
+//Mede enfileirar e desenfileirar n ocorrências
+void benchmark_filas(long n) {
+    estado_aleatorio = SEMENTE_BENCHMARK;
+    Ocorrencia** ocorrencias = criar_ocorrencias_sinteticas(n);
+    if (!ocorrencias) return;
+    
+    Fila* fila = criar_fila();
+    long soma = 0;
+    
+    double inicio = tempo_em_segundos();
+    for (long i = 0; i < n; i++) {
+        enfileirar(fila, ocorrencias[i]);
+    }
+    reportar("filas", "circular", n, "enfileirar", n, tempo_em_segundos() - inicio);
+    
+    inicio = tempo_em_segundos();
+    for (long i = 0; i < n; i++) {
+        Ocorrencia* ocorrencia = desenfileirar(fila);
+        soma += ocorrencia ? ocorrencia->id : -1;
+    }
+    reportar("filas", "circular", n, "desenfileirar", n, tempo_em_segundos() - inicio);
+    
+    if (soma < 0) fprintf(stderr, "Fila esvaziou antes do esperado\n");
+    
+    liberar_fila(fila);
+    for (long i = 0; i < n; i++) {
+        liberar_ocorrencia(ocorrencias[i]);
+    }
+    free(ocorrencias);
+}
+
+// ==================== HISTÓRICO ====================
+
+//Mede empilhar n atendimentos no histórico
+void benchmark_historico(long n) {
+    estado_aleatorio = SEMENTE_BENCHMARK;
+    PilhaHistorico* pilha = criar_pilha_historico();
+    
+    double inicio = tempo_em_segundos();
+    for (long i = 0; i < n; i++) {
+        empilhar_historico(pilha, (int)i + 1, (int)(i % BAIRROS_BENCHMARK), AMBULANCIA,
+                           1 + (int)(proximo_aleatorio() % NIVEIS_GRAVIDADE), (int)i, (int)i + DURACAO_AMBULANCIA,
+                           "Atendimento concluído");
+    }
+    reportar("historico", "pilha", n, "empilhar", n, tempo_em_segundos() - inicio);
+    
+    liberar_pilha_historico(pilha);
+}
+
+// ==================== UNIDADES ====================
+
+//Mede o registro de uma frota de n unidades: cadastro, despacho e devolução,
+//e as consultas de disponibilidade (primeira livre e contagens de livres e por tipo)
+void benchmark_unidades(long n) {
+    estado_aleatorio = SEMENTE_BENCHMARK;
+    RegistroUnidades* registro = criar_registro_unidades();
+    long soma = 0;
+    
+    double inicio = tempo_em_segundos();
+    for (long i = 0; i < n; i++) {
+        inserir_unidade(registro, (int)i + 1, (TipoServico)(i % NUM_TIPOS_SERVICO), "Unidade");
+    }
+    reportar("unidades", "soa_bitset", n, "cadastrar", n, tempo_em_segundos() - inicio);
+    
+    //Metade da frota sai em atendimento e volta em ordem sorteada
+    int* ocupadas = (int*)malloc((size_t)(n / 2 + 1) * sizeof(int));
+    if (!ocupadas) {
+        fprintf(stderr, "Memória insuficiente para %ld unidades\n", n);
+        liberar_registro_unidades(registro);
+        return;
+    }
+    inicio = tempo_em_segundos();
+    for (long i = 0; i < n / 2; i++) {
+        ocupadas[i] = ocupar_unidade_livre(registro, (TipoServico)(i % NUM_TIPOS_SERVICO));
+    }
+    reportar("unidades", "soa_bitset", n, "ocupar", n / 2, tempo_em_segundos() - inicio);
+    
+    for (long i = n / 2 - 1; i > 0; i--) {
+        long j = (long)(proximo_aleatorio() % (uint64_t)(i + 1));
+        int temp = ocupadas[i];
+        ocupadas[i] = ocupadas[j];
+        ocupadas[j] = temp;
+    }
+    inicio = tempo_em_segundos();
+    for (long i = 0; i < n / 2; i++) {
+        devolver_unidade_livre(registro, ocupadas[i]);
+    }
+    reportar("unidades", "soa_bitset", n, "devolver", n / 2, tempo_em_segundos() - inicio);
+    free(ocupadas);
+    
+    inicio = tempo_em_segundos();
+    for (long i = 0; i < n; i++) {
+        soma += primeira_unidade_livre(registro, (TipoServico)(i % NUM_TIPOS_SERVICO));
+    }
+    reportar("unidades", "soa_bitset", n, "primeira_livre", n, tempo_em_segundos() - inicio);
+    
+    inicio = tempo_em_segundos();
+    for (long i = 0; i < CONSULTAS_FROTA_BENCHMARK; i++) {
+        soma += contar_unidades_livres(registro, (TipoServico)(i % NUM_TIPOS_SERVICO));
+    }
+    reportar("unidades", "soa_bitset", n, "contar_livres", CONSULTAS_FROTA_BENCHMARK, tempo_em_segundos() - inicio);
+    
+    inicio = tempo_em_segundos();
+    for (long i = 0; i < CONSULTAS_FROTA_BENCHMARK; i++) {
+        soma += contar_unidades_tipo(registro, (TipoServico)(i % NUM_TIPOS_SERVICO));
+    }
+    reportar("unidades", "soa_bitset", n, "contar_tipo", CONSULTAS_FROTA_BENCHMARK, tempo_em_segundos() - inicio);
+    
+    //Confere o resultado para que o compilador não descarte as consultas
+    if (soma < 0) fprintf(stderr, "Consulta da frota falhou durante o benchmark\n");
+    
+    liberar_registro_unidades(registro);
+}
+
+// ==================== TEMPOS DE RESPOSTA ====================
+
+//Mede o registro de n atendimentos nos histogramas (serviço e bairro) e consultas de percentil
+void benchmark_latencias(long n) {
+    estado_aleatorio = SEMENTE_BENCHMARK;
+    PainelLatencias* painel = criar_painel_latencias();
+    long soma = 0;
+    
+    double inicio = tempo_em_segundos();
+    for (long i = 0; i < n; i++) {
+        registrar_latencias(painel, (TipoServico)(i % NUM_TIPOS_SERVICO), (int)(proximo_aleatorio() % BAIRROS_BENCHMARK),
+                            (int)(proximo_aleatorio() % 1000));
+    }
+    reportar("latencias", "hdr", n, "registrar", n, tempo_em_segundos() - inicio);
+    
+    inicio = tempo_em_segundos();
+    for (long i = 0; i < CONSULTAS_FROTA_BENCHMARK; i++) {
+        soma += percentil_histograma(&painel->por_servico[i % NUM_TIPOS_SERVICO].espera, 99);
+    }
+    reportar("latencias", "hdr", n, "p99", CONSULTAS_FROTA_BENCHMARK, tempo_em_segundos() - inicio);
+    
+    //Confere o resultado para que o compilador não descarte as consultas
+    if (soma < 0) fprintf(stderr, "Percentil falhou durante o benchmark\n");
+    
+    liberar_painel_latencias(painel);
+}
+
+// ==================== MAPA DA CIDADE ====================
+
+//Mede n atualizações de unidades disponíveis no mapa e n totais de um serviço na cidade
+void benchmark_mapa(long n) {
+    estado_aleatorio = SEMENTE_BENCHMARK;
+    ListaCruzada* mapa = criar_lista_cruzada();
+    for (int b = 1; b <= BAIRROS_BENCHMARK; b++) {
+        inserir_bairro_servico(mapa, b, "Bairro");
+        for (int t = 0; t < NUM_TIPOS_SERVICO; t++) {
+            adicionar_servico_bairro(mapa, b, (TipoServico)t);
+        }
+    }
+    
+    double inicio = tempo_em_segundos();
+    for (long i = 0; i < n; i++) {
+        atualizar_unidades_disponiveis(mapa, 1 + (int)(proximo_aleatorio() % BAIRROS_BENCHMARK),
+                                       (TipoServico)(i % NUM_TIPOS_SERVICO), (i & 1) ? -1 : 1);
+    }
+    reportar("mapa", "matriz", n, "atualizar", n, tempo_em_segundos() - inicio);
+    
+    long total = 0;
+    inicio = tempo_em_segundos();
+    for (long i = 0; i < n; i++) {
+        total += total_unidades_disponiveis(mapa, (TipoServico)(i % NUM_TIPOS_SERVICO));
+    }
+    reportar("mapa", "matriz", n, "total_cidade", n, tempo_em_segundos() - inicio);
+    
+    //Confere o resultado para que o compilador não descarte as somas
+    if (total < 0) fprintf(stderr, "Soma do mapa falhou durante o benchmark\n");
+    
+    liberar_lista_cruzada(mapa);
+}
+
+// ==================== ÁRVORES BST E AVL ====================
+
+//Mede inserção, busca e remoção com n ocorrências de IDs embaralhados
+//(com IDs crescentes, como no sistema, a BST vira uma lista)
+void benchmark_arvores_bst_avl(long n) {
+    estado_aleatorio = SEMENTE_BENCHMARK;
+    Ocorrencia** ocorrencias = criar_ocorrencias_sinteticas(n);
+    if (!ocorrencias) return;
+    long soma = 0;
+    
+    ArvoreAVL* avl = criar_arvore_avl();
+    double inicio = tempo_em_segundos();
+    for (long i = 0; i < n; i++) {
+        inserir_avl_arvore(avl, ocorrencias[i]);
+    }
+    reportar("arvores", "avl", n, "inserir", n, tempo_em_segundos() - inicio);
+    
+    inicio = tempo_em_segundos();
+    for (long i = 0; i < n; i++) {
+        Ocorrencia* alvo = ocorrencias[proximo_aleatorio() % n];
+        soma += buscar_ocorrencia_avl(avl, alvo->gravidade, alvo->id) != NULL;
+    }
+    reportar("arvores", "avl", n, "buscar", n, tempo_em_segundos() - inicio);
+    
+    inicio = tempo_em_segundos();
+    for (long i = 0; i < n; i += 2) {
+        remover_ocorrencia_avl(avl, ocorrencias[i]->gravidade, ocorrencias[i]->id);
+    }
+    reportar("arvores", "avl", n, "remover", (n + 1) / 2, tempo_em_segundos() - inicio);
+    liberar_avl_completa(avl);
+    
+    //A BST é dona das ocorrências: as removidas e as que sobram são liberadas por ela
+    ArvoreBST* bst = criar_arvore_bst();
+    inicio = tempo_em_segundos();
+    for (long i = 0; i < n; i++) {
+        inserir_bst(bst, ocorrencias[i]);
+    }
+    reportar("arvores", "bst", n, "inserir", n, tempo_em_segundos() - inicio);
+    
+    inicio = tempo_em_segundos();
+    for (long i = 0; i < n; i++) {
+        soma += buscar_ocorrencia_por_id(bst, 1 + (int)(proximo_aleatorio() % n)) != NULL;
+    }
+    reportar("arvores", "bst", n, "buscar", n, tempo_em_segundos() - inicio);
+    
+    inicio = tempo_em_segundos();
+    for (long i = 0; i < n; i += 2) {
+        remover_ocorrencia_bst(bst, ocorrencias[i]->id);
+    }
+    reportar("arvores", "bst", n, "remover", (n + 1) / 2, tempo_em_segundos() - inicio);
+    liberar_bst_completa(bst);
+    
+    if (soma < 0) fprintf(stderr, "Busca falhou durante o benchmark\n");
+    free(ocorrencias);
+}
+
+// ==================== ÍNDICES DE PRIORIDADE ====================
+
+//Reclassifica os alvos para a gravidade seguinte (circular) na AVL ou, sem árvore, na fila de baldes
+void medir_reclassificacoes(const char* backend, ArvoreAVL* arvore, FilaBaldes* fila, long n,
+                            const char* operacao, Ocorrencia** alvos, long quantidade) {
+    double inicio = tempo_em_segundos();
+    for (long i = 0; i < quantidade; i++) {
+        int nova_gravidade = alvos[i]->gravidade % NIVEIS_GRAVIDADE + 1;
+        if (arvore) {
+            reclassificar_avl(arvore, alvos[i], nova_gravidade);
+        } else {
+            reclassificar_fila_baldes(fila, alvos[i], nova_gravidade);
+        }
+    }
+    reportar("prioridades", backend, n, operacao, quantidade, tempo_em_segundos() - inicio);
+}
+
+//Mede inserção, remoção arbitrária e extração da maior prioridade com n ocorrências pendentes
+//Roda a mesma sequência na árvore AVL e na fila de baldes
+void benchmark_prioridades(long n) {
+    estado_aleatorio = SEMENTE_BENCHMARK;
+    Ocorrencia** ocorrencias = criar_ocorrencias_sinteticas(n);
+    if (!ocorrencias) return;
+    
+    //Os IDs já estão embaralhados; a inserção segue a ordem de ID, como no sistema,
+    //e as remoções seguem a ordem embaralhada
+    Ocorrencia** por_id = (Ocorrencia**)malloc((size_t)n * sizeof(Ocorrencia*));
+    if (!por_id) {
+        fprintf(stderr, "Memória insuficiente para %ld ocorrências\n", n);
+        free(ocorrencias);
+        return;
+    }
+    for (long i = 0; i < n; i++) {
+        por_id[ocorrencias[i]->id - 1] = ocorrencias[i];
+    }
+    
+    long extraidas = 0;
+    
+    //Reclassificações de chamados recentes, sorteados e antigos: nos baldes, uma reclassificada
+    //mais antiga que o fim do balde de destino vai para a árvore dele, então a idade pesa no custo
+    long reclassificacoes = n < RECLASSIFICACOES_BENCHMARK ? n : RECLASSIFICACOES_BENCHMARK;
+    Ocorrencia** recentes = por_id + (n - reclassificacoes);
+    Ocorrencia** antigas = por_id;
+    Ocorrencia* sorteadas[RECLASSIFICACOES_BENCHMARK];
+    for (long i = 0; i < reclassificacoes; i++) {
+        sorteadas[i] = por_id[proximo_aleatorio() % (uint64_t)n];
+    }
+    
+    //Árvore AVL
+    ArvoreAVL* arvore = criar_arvore_avl();
+    double inicio = tempo_em_segundos();
+    for (long i = 0; i < n; i++) {
+        inserir_avl_arvore(arvore, por_id[i]);
+    }
+    reportar("prioridades", "avl", n, "inserir", n, tempo_em_segundos() - inicio);
+    
+    medir_reclassificacoes("avl", arvore, NULL, n, "reclassificar_recentes", recentes, reclassificacoes);
+    medir_reclassificacoes("avl", arvore, NULL, n, "reclassificar_sorteadas", sorteadas, reclassificacoes);
+    medir_reclassificacoes("avl", arvore, NULL, n, "reclassificar_antigas", antigas, reclassificacoes);
+    
+    inicio = tempo_em_segundos();
+    for (long i = 0; i < n / 2; i++) {
+        remover_ocorrencia_avl(arvore, ocorrencias[i]->gravidade, ocorrencias[i]->id);
+    }
+    reportar("prioridades", "avl", n, "remover", n / 2, tempo_em_segundos() - inicio);
+    
+    inicio = tempo_em_segundos();
+    for (long i = 0; i < n - n / 2; i++) {
+        extraidas += extrair_maior_prioridade(arvore, (TipoServico)(i % NUM_TIPOS_SERVICO)) != NULL;
+    }
+    reportar("prioridades", "avl", n, "extrair_maior", n - n / 2, tempo_em_segundos() - inicio);
+    liberar_avl_completa(arvore);
+    
+    //Fila de baldes
+    FilaBaldes* fila = criar_fila_baldes();
+    inicio = tempo_em_segundos();
+    for (long i = 0; i < n; i++) {
+        inserir_fila_baldes(fila, por_id[i]);
+    }
+    reportar("prioridades", "baldes", n, "inserir", n, tempo_em_segundos() - inicio);
+    
+    medir_reclassificacoes("baldes", NULL, fila, n, "reclassificar_recentes", recentes, reclassificacoes);
+    medir_reclassificacoes("baldes", NULL, fila, n, "reclassificar_sorteadas", sorteadas, reclassificacoes);
+    medir_reclassificacoes("baldes", NULL, fila, n, "reclassificar_antigas", antigas, reclassificacoes);
+    
+    inicio = tempo_em_segundos();
+    for (long i = 0; i < n / 2; i++) {
+        remover_fila_baldes(fila, ocorrencias[i]);
+    }
+    reportar("prioridades", "baldes", n, "remover", n / 2, tempo_em_segundos() - inicio);
+    
+    inicio = tempo_em_segundos();
+    for (long i = 0; i < n - n / 2; i++) {
+        extraidas += extrair_maior_prioridade_baldes(fila, (TipoServico)(i % NUM_TIPOS_SERVICO)) != NULL;
+    }
+    reportar("prioridades", "baldes", n, "extrair_maior", n - n / 2, tempo_em_segundos() - inicio);
+    liberar_fila_baldes(fila);
+    
+    //Confere o resultado para que o compilador não descarte as extrações
+    if (extraidas < 0) fprintf(stderr, "Extração falhou durante o benchmark\n");
+    
+    for (long i = 0; i < n; i++) {
+        liberar_ocorrencia(ocorrencias[i]);
+    }
+    free(por_id);
+    free(ocorrencias);
+}
+
+// ==================== SISTEMA (POR UNIDADE DE TEMPO) ====================
+
+//Cria um sistema com BAIRROS_BENCHMARK bairros e UNIDADES_BENCHMARK unidades de cada serviço
+SistemaEmergencia* criar_sistema_benchmark() {
+    SistemaEmergencia* sistema = inicializar_sistema();
+    
+    for (int b = 1; b <= BAIRROS_BENCHMARK; b++) {
+        cadastrar_bairro_sistema(sistema, b, "Bairro");
+        for (int t = 0; t < NUM_TIPOS_SERVICO; t++) {
+            adicionar_servico_bairro(sistema->mapa_cidade, b, (TipoServico)t);
+        }
+    }
+    for (int u = 0; u < UNIDADES_BENCHMARK * NUM_TIPOS_SERVICO; u++) {
+        cadastrar_unidade_sistema(sistema, u + 1, (TipoServico)(u % NUM_TIPOS_SERVICO), "Unidade");
+    }
+    
+    return sistema;
+}
+
+//Mede o custo de uma unidade de tempo do sistema completo: chegadas, liberações e despachos
+//Roda n / CHEGADAS_POR_TICK unidades de tempo com CHEGADAS_POR_TICK ocorrências novas em cada uma
+void benchmark_sistema(long n) {
+    estado_aleatorio = SEMENTE_BENCHMARK;
+    SistemaEmergencia* sistema = criar_sistema_benchmark();
+    
+    long ticks = n / CHEGADAS_POR_TICK > 0 ? n / CHEGADAS_POR_TICK : 1;
+    double inicio = tempo_em_segundos();
+    for (long t = 0; t < ticks; t++) {
+        for (int c = 0; c < CHEGADAS_POR_TICK; c++) {
+            receber_ocorrencia(sistema, 1 + (int)(proximo_aleatorio() % BAIRROS_BENCHMARK),
+                               (TipoServico)(proximo_aleatorio() % NUM_TIPOS_SERVICO),
+                               1 + (int)(proximo_aleatorio() % NIVEIS_GRAVIDADE));
+        }
+        simular_tempo(sistema, 1);
+    }
+    reportar("sistema", modo_despacho_string(sistema->modo_despacho), n, "tick", ticks, tempo_em_segundos() - inicio);
+    
+    liberar_sistema(sistema);
+}
+
+// ==================== SIMULAÇÃO POR EVENTOS (UM MÊS) ====================
+
+//Mede a simulação de TEMPOS_SIMULACAO_BENCHMARK unidades de tempo com n chamados agendados de uma vez
+//"evento" é o custo médio de cada evento do calendário; "mes" é o custo da simulação inteira
+void benchmark_simulacao(long n) {
+    SistemaEmergencia* sistema = criar_sistema_benchmark();
+    
+    double inicio = tempo_em_segundos();
+    int agendados = gerar_trafego(sistema, (int)n, TEMPOS_SIMULACAO_BENCHMARK, SEMENTE_BENCHMARK);
+    reportar("simulacao", "calendario", n, "agendar_chamado", agendados, tempo_em_segundos() - inicio);
+    
+    long long antes = sistema->calendario->processados;
+    inicio = tempo_em_segundos();
+    simular_tempo(sistema, TEMPOS_SIMULACAO_BENCHMARK);
+    double segundos = tempo_em_segundos() - inicio;
+    reportar("simulacao", "calendario", n, "evento", (long)(sistema->calendario->processados - antes), segundos);
+    reportar("simulacao", "calendario", n, "mes", 1, segundos);
+    
+    liberar_sistema(sistema);
+}
+
+//Roda todos os módulos com n elementos
+void executar_benchmarks(long n) {
+    benchmark_bairros(n);
+    benchmark_cidadaos(n);
+    benchmark_filas(n);
+    benchmark_historico(n);
+    benchmark_unidades(n);
+    benchmark_latencias(n);
+    benchmark_mapa(n);
+    benchmark_arvores_bst_avl(n);
+    benchmark_prioridades(n);
+    benchmark_sistema(n);
+    benchmark_simulacao(n);
+}
+
+int main(int argc, char* argv[]) {
+    //Os resultados vão para a saída padrão original; o resto do que o sistema imprime é descartado
+    saida = fdopen(dup(STDOUT_FILENO), "w");
+    if (!saida || !freopen("/dev/null", "w", stdout)) {
+        fprintf(stderr, "Não foi possível preparar a saída do benchmark\n");
+        return 1;
+    }
+    
+    //As medições não incluem o custo das mensagens do sistema
+    definir_nivel_log(NIVEL_LOG_SILENCIOSO);
+    
+    if (argc >= 4 && strcmp(argv[1], "arvores") == 0) {
+        int sucesso = benchmark_arvores(atol(argv[2]), atol(argv[3]), argc >= 5 ? argv[4] : NULL, saida);
+        fclose(saida);
+        return sucesso ? 0 : 1;
+    }
+    
+    if (argc >= 2 && strcmp(argv[1], "cidadaos") == 0) {
+        aquecendo = 1;
+        benchmark_cidadaos(N_AQUECIMENTO);
+        aquecendo = 0;
+        
+        fprintf(saida, "modulo,backend,n,operacao,ns_por_op\n");
+        if (argc > 2) {
+            for (int i = 2; i < argc; i++) {
+                benchmark_cidadaos(atol(argv[i]));
+            }
+        } else {
+            benchmark_cidadaos(1000000);
+            benchmark_cidadaos(10000000);
+        }
+        fclose(saida);
+        return 0;
+    }
+    
+    //Aquecimento: aloca os blocos dos pools e aquece caches e preditores antes das medições
+    aquecendo = 1;
+    executar_benchmarks(N_AQUECIMENTO);
+    aquecendo = 0;
+    
+    fprintf(saida, "modulo,backend,n,operacao,ns_por_op\n");
+    
+    if (argc > 1) {
+        for (int i = 1; i < argc; i++) {
+            executar_benchmarks(atol(argv[i]));
+        }
+    } else {
+        executar_benchmarks(100000);
+        executar_benchmarks(1000000);
+    }
+    
+    fclose(saida);
+    return 0;
+}
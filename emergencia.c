@@ -1,11 +1,69 @@
+#define _POSIX_C_SOURCE 200809L //Necessário para clock_gettime com -std=c99
+
 #include "emergencia.h"
 #include <math.h>
+#include <errno.h>
+#include <limits.h>
+#include <sched.h>
 
 // ==================== IMPLEMENTAÇÃO - HASH/BAIRROS ====================
 
-//Função hash simples para IDs de bairros
+//Função hash para IDs de bairros (mistura os bits para usar máscara de potência de 2)
 int hash_bairro(int id) {
-    return id % TAM_HASH;
+    unsigned int h = (unsigned int)id;
+    h ^= h >> 16;
+    h *= 0x45d9f3bu;
+    h ^= h >> 16;
+    return (int)(h & 0x7fffffff);
+}
+
+//Aloca um vetor de baldes vazio
+Bairro** alocar_baldes_bairros(int capacidade) {
+    return (Bairro**)calloc(capacidade, sizeof(Bairro*));
+}
+
+//Migra alguns baldes da tabela antiga para a atual (rehash incremental)
+void migrar_baldes_bairros(TabelaHashBairros* tabela, int baldes) {
+    if (!tabela->tabela_antiga) return;
+    
+    while (baldes-- > 0 && tabela->indice_migracao < tabela->capacidade_antiga) {
+        Bairro* atual = tabela->tabela_antiga[tabela->indice_migracao];
+        tabela->tabela_antiga[tabela->indice_migracao++] = NULL;
+        
+        while (atual) {
+            Bairro* proximo = atual->prox;
+            int indice = hash_bairro(atual->id) & (tabela->capacidade - 1);
+            atual->prox = tabela->tabela[indice];
+            tabela->tabela[indice] = atual;
+            atual = proximo;
+        }
+    }
+    
+    //Terminou a migração: descarta a tabela antiga
+    if (tabela->indice_migracao >= tabela->capacidade_antiga) {
+        free(tabela->tabela_antiga);
+        tabela->tabela_antiga = NULL;
+        tabela->capacidade_antiga = 0;
+        tabela->indice_migracao = 0;
+    }
+}
+
+//Dobra a capacidade quando o fator de carga passa do limite
+//Os baldes antigos são migrados aos poucos nas operações seguintes
+void crescer_tabela_bairros(TabelaHashBairros* tabela) {
+    if (tabela->quantidade * 4 < tabela->capacidade * 3) return;
+    
+    //Se ainda havia migração pendente, conclui antes de iniciar outra
+    migrar_baldes_bairros(tabela, tabela->capacidade_antiga);
+    
+    Bairro** nova = alocar_baldes_bairros(tabela->capacidade * 2);
+    if (!nova) return; //Sem memória: continua com a tabela atual
+    
+    tabela->tabela_antiga = tabela->tabela;
+    tabela->capacidade_antiga = tabela->capacidade;
+    tabela->indice_migracao = 0;
+    tabela->tabela = nova;
+    tabela->capacidade *= 2;
 }
 
 //Cria uma nova tabela hash para bairros
@@ -14,9 +72,16 @@ TabelaHashBairros* criar_tabela_bairros() {
     if (!tabela) return NULL;
     
     //Inicializa todas as posições como NULL
-    for (int i = 0; i < TAM_HASH; i++) {
-        tabela->tabela[i] = NULL;
+    tabela->tabela = alocar_baldes_bairros(TAM_HASH_INICIAL);
+    if (!tabela->tabela) {
+        free(tabela);
+        return NULL;
     }
+    tabela->capacidade = TAM_HASH_INICIAL;
+    tabela->tabela_antiga = NULL;
+    tabela->capacidade_antiga = 0;
+    tabela->indice_migracao = 0;
+    tabela->quantidade = 0;
     
     return tabela;
 }
@@ -28,14 +93,17 @@ int inserir_bairro(TabelaHashBairros* tabela, int id, const char* nome) {
     //Verifica se já existe
     if (buscar_bairro(tabela, id)) return 0;
     
-    int indice = hash_bairro(id);
     Bairro* novo = (Bairro*)malloc(sizeof(Bairro));
     if (!novo) return 0;
     
+    crescer_tabela_bairros(tabela);
+    
+    int indice = hash_bairro(id) & (tabela->capacidade - 1);
     novo->id = id;
-    strcpy(novo->nome, nome);
+    snprintf(novo->nome, sizeof(novo->nome), "%s", nome);
     novo->prox = tabela->tabela[indice];  //Encadeamento para tratar colisões
     tabela->tabela[indice] = novo;
+    tabela->quantidade++;
     
     return 1;
 }
@@ -44,48 +112,66 @@ int inserir_bairro(TabelaHashBairros* tabela, int id, const char* nome) {
 Bairro* buscar_bairro(TabelaHashBairros* tabela, int id) {
     if (!tabela) return NULL;
     
-    int indice = hash_bairro(id);
-    Bairro* atual = tabela->tabela[indice];
+    migrar_baldes_bairros(tabela, BALDES_MIGRADOS_POR_OPERACAO);
+    
+    int hash = hash_bairro(id);
+    Bairro* atual = tabela->tabela[hash & (tabela->capacidade - 1)];
     
     while (atual) {
         if (atual->id == id) return atual;
         atual = atual->prox;
     }
     
+    //Durante o rehash o bairro ainda pode estar em um balde não migrado
+    if (tabela->tabela_antiga) {
+        atual = tabela->tabela_antiga[hash & (tabela->capacidade_antiga - 1)];
+        while (atual) {
+            if (atual->id == id) return atual;
+            atual = atual->prox;
+        }
+    }
+    
     return NULL;
 }
 
-//Lista todos os bairros cadastrados
-void listar_bairros(TabelaHashBairros* tabela) {
-    if (!tabela) return;
-    
-    printf("\n=== BAIRROS CADASTRADOS ===\n");
+//Mostra os bairros de um vetor de baldes
+int listar_baldes_bairros(Bairro** baldes, int capacidade) {
     int encontrou = 0;
-    for (int i = 0; i < TAM_HASH; i++) {
-        Bairro* atual = tabela->tabela[i];
+    for (int i = 0; i < capacidade; i++) {
+        Bairro* atual = baldes[i];
         while (atual) {
             printf("ID: %d - Nome: %s\n", atual->id, atual->nome);
             atual = atual->prox;
             encontrou = 1;
         }
     }
+    return encontrou;
+}
+
+//Lista todos os bairros cadastrados
+void listar_bairros(TabelaHashBairros* tabela) {
+    if (!tabela) return;
+    
+    printf("\n=== BAIRROS CADASTRADOS ===\n");
+    int encontrou = 0;
+    if (tabela->tabela_antiga) {
+        encontrou = listar_baldes_bairros(tabela->tabela_antiga, tabela->capacidade_antiga);
+    }
+    encontrou |= listar_baldes_bairros(tabela->tabela, tabela->capacidade);
     if (!encontrou) {
         printf("Nenhum bairro cadastrado.\n");
     }
 }
 
-//Remove um bairro da tabela hash
-int remover_bairro(TabelaHashBairros* tabela, int id) {
-    if (!tabela) return 0;
-    
-    int indice = hash_bairro(id);
-    Bairro* atual = tabela->tabela[indice];
+//Remove um bairro de uma lista de colisões
+int remover_bairro_balde(Bairro** balde, int id) {
+    Bairro* atual = *balde;
     Bairro* anterior = NULL;
     
     while (atual) {
         if (atual->id == id) {
             if (anterior == NULL) {
-                tabela->tabela[indice] = atual->prox;
+                *balde = atual->prox;
             } else {
                 anterior->prox = atual->prox;
             }
@@ -99,33 +185,205 @@ int remover_bairro(TabelaHashBairros* tabela, int id) {
     return 0;
 }
 
-//Libera memória da tabela de bairros
-void liberar_tabela_bairros(TabelaHashBairros* tabela) {
-    if (!tabela) return;
+//Remove um bairro da tabela hash
+int remover_bairro(TabelaHashBairros* tabela, int id) {
+    if (!tabela) return 0;
+    
+    migrar_baldes_bairros(tabela, BALDES_MIGRADOS_POR_OPERACAO);
+    
+    int hash = hash_bairro(id);
+    if (remover_bairro_balde(&tabela->tabela[hash & (tabela->capacidade - 1)], id) ||
+        (tabela->tabela_antiga &&
+         remover_bairro_balde(&tabela->tabela_antiga[hash & (tabela->capacidade_antiga - 1)], id))) {
+        tabela->quantidade--;
+        return 1;
+    }
     
-    for (int i = 0; i < TAM_HASH; i++) {
-        Bairro* atual = tabela->tabela[i];
+    return 0;
+}
+
+//Libera os bairros de um vetor de baldes
+void liberar_baldes_bairros(Bairro** baldes, int capacidade) {
+    for (int i = 0; i < capacidade; i++) {
+        Bairro* atual = baldes[i];
         while (atual) {
             Bairro* temp = atual;
             atual = atual->prox;
             free(temp);
         }
     }
+    free(baldes);
+}
+
+//Libera memória da tabela de bairros
+void liberar_tabela_bairros(TabelaHashBairros* tabela) {
+    if (!tabela) return;
+    
+    liberar_baldes_bairros(tabela->tabela, tabela->capacidade);
+    if (tabela->tabela_antiga) {
+        liberar_baldes_bairros(tabela->tabela_antiga, tabela->capacidade_antiga);
+    }
     free(tabela);
 }
 
 // ==================== IMPLEMENTAÇÃO - HASH/CIDADÃOS ====================
 
-//Função hash para CPF
-int hash_cpf(const char* cpf) {
-    if (!cpf) return 0;
-    int hash = 0;
+//Converte um CPF (formatado ou não) em uma chave inteira de 11 dígitos
+//Aceita pontos, hífens e espaços como separadores; retorna 0 se o CPF for inválido
+int normalizar_cpf(const char* cpf, uint64_t* chave) {
+    if (!cpf || !chave) return 0;
+    
+    uint64_t valor = 0;
+    int digitos = 0;
     for (int i = 0; cpf[i] != '\0'; i++) {
         if (cpf[i] >= '0' && cpf[i] <= '9') {
-            hash = (hash * 10 + (cpf[i] - '0')) % TAM_HASH;
+            if (++digitos > DIGITOS_CPF) return 0;
+            valor = valor * 10 + (uint64_t)(cpf[i] - '0');
+        } else if (cpf[i] != '.' && cpf[i] != '-' && cpf[i] != ' ') {
+            return 0;
+        }
+    }
+    
+    if (digitos != DIGITOS_CPF) return 0;
+    *chave = valor;
+    return 1;
+}
+
+//Escreve a chave do CPF no formato XXX.XXX.XXX-XX (destino com pelo menos MAX_CPF posições)
+void formatar_cpf(uint64_t chave, char* destino) {
+    snprintf(destino, MAX_CPF, "%03u.%03u.%03u-%02u",
+             (unsigned)(chave / 100000000ULL % 1000), (unsigned)(chave / 100000ULL % 1000),
+             (unsigned)(chave / 100ULL % 1000), (unsigned)(chave % 100));
+}
+
+//Função hash para a chave do CPF (finalizador do splitmix64, espalha bem os bits)
+uint64_t hash_chave_cpf(uint64_t chave) {
+    chave ^= chave >> 30;
+    chave *= 0xbf58476d1ce4e5b9ULL;
+    chave ^= chave >> 27;
+    chave *= 0x94d049bb133111ebULL;
+    chave ^= chave >> 31;
+    return chave;
+}
+
+//Função hash para CPF em texto
+int hash_cpf(const char* cpf) {
+    uint64_t chave;
+    if (!normalizar_cpf(cpf, &chave)) return 0;
+    return (int)(hash_chave_cpf(chave) & 0x7fffffff);
+}
+
+#ifdef CIDADAOS_TABELA_PLANA
+
+// ==================== IMPLEMENTAÇÃO - HASH/CIDADÃOS (TABELA PLANA) ====================
+//Endereçamento aberto com Robin Hood: o índice guarda só a chave e a posição do registro,
+//e os registros ficam contíguos em um único vetor (sem um malloc por cidadão)
+
+//Aloca um índice com todas as entradas vazias
+EntradaIndiceCidadao* alocar_indice_cidadaos(int capacidade) {
+    EntradaIndiceCidadao* indice = (EntradaIndiceCidadao*)malloc(capacidade * sizeof(EntradaIndiceCidadao));
+    if (!indice) return NULL;
+    
+    for (int i = 0; i < capacidade; i++) {
+        indice[i].registro = ENTRADA_CIDADAO_VAZIA;
+    }
+    return indice;
+}
+
+//Insere uma chave no índice atual (Robin Hood: quem está mais longe da posição ideal fica com a vaga)
+void inserir_indice_cidadao(TabelaHashCidadaos* tabela, uint64_t chave, int registro) {
+    EntradaIndiceCidadao entrada = { chave, registro, 0 };
+    int mascara = tabela->capacidade - 1;
+    int posicao = (int)(hash_chave_cpf(chave) & mascara);
+    
+    while (tabela->indice[posicao].registro >= 0) {
+        if (tabela->indice[posicao].distancia < entrada.distancia) {
+            EntradaIndiceCidadao temp = tabela->indice[posicao];
+            tabela->indice[posicao] = entrada;
+            entrada = temp;
+        }
+        posicao = (posicao + 1) & mascara;
+        entrada.distancia++;
+    }
+    
+    tabela->indice[posicao] = entrada;
+}
+
+//Retorna a posição da chave em um índice, ou -1 se não existir
+//As lápides continuam na sondagem, mas nunca coincidem com a chave
+int procurar_indice_cidadao(EntradaIndiceCidadao* indice, int capacidade, uint64_t chave) {
+    int mascara = capacidade - 1;
+    int posicao = (int)(hash_chave_cpf(chave) & mascara);
+    int distancia = 0;
+    
+    //A busca para assim que encontra uma entrada mais próxima da sua posição ideal
+    while (indice[posicao].registro != ENTRADA_CIDADAO_VAZIA && indice[posicao].distancia >= distancia) {
+        if (indice[posicao].registro >= 0 && indice[posicao].cpf == chave) return posicao;
+        posicao = (posicao + 1) & mascara;
+        distancia++;
+    }
+    
+    return -1;
+}
+
+//Retorna a posição da chave no índice atual, ou -1 se não existir
+int posicao_indice_cidadao(TabelaHashCidadaos* tabela, uint64_t chave) {
+    return procurar_indice_cidadao(tabela->indice, tabela->capacidade, chave);
+}
+
+//Migra algumas entradas do índice antigo para o atual (rehash incremental)
+//O índice antigo não é alterado pela migração, então as buscas nele continuam valendo
+void migrar_indice_cidadaos(TabelaHashCidadaos* tabela, int entradas) {
+    if (!tabela->indice_antigo) return;
+    
+    while (entradas-- > 0 && tabela->indice_migracao < tabela->capacidade_antiga) {
+        EntradaIndiceCidadao* entrada = &tabela->indice_antigo[tabela->indice_migracao++];
+        if (entrada->registro >= 0) {
+            inserir_indice_cidadao(tabela, entrada->cpf, entrada->registro);
+        }
+    }
+    
+    //Terminou a migração: descarta o índice antigo
+    if (tabela->indice_migracao >= tabela->capacidade_antiga) {
+        free(tabela->indice_antigo);
+        tabela->indice_antigo = NULL;
+        tabela->capacidade_antiga = 0;
+        tabela->indice_migracao = 0;
+    }
+}
+
+//Dobra o índice quando o fator de carga passa do limite
+//As entradas antigas são migradas aos poucos nas operações seguintes
+int crescer_indice_cidadaos(TabelaHashCidadaos* tabela) {
+    if ((tabela->quantidade + 1) * 4 < tabela->capacidade * 3) return 1;
+    
+    //Se ainda havia migração pendente, conclui antes de iniciar outra
+    migrar_indice_cidadaos(tabela, tabela->capacidade_antiga);
+    
+    EntradaIndiceCidadao* novo = alocar_indice_cidadaos(tabela->capacidade * 2);
+    if (!novo) return 0;
+    
+    tabela->indice_antigo = tabela->indice;
+    tabela->capacidade_antiga = tabela->capacidade;
+    tabela->indice_migracao = 0;
+    tabela->indice = novo;
+    tabela->capacidade *= 2;
+    
+    return 1;
+}
+
+//Aponta a chave para uma nova posição no vetor de registros, nos dois índices
+void atualizar_registro_cidadao(TabelaHashCidadaos* tabela, uint64_t chave, int registro) {
+    int posicao = posicao_indice_cidadao(tabela, chave);
+    if (posicao >= 0) {
+        tabela->indice[posicao].registro = registro;
+    }
+    if (tabela->indice_antigo) {
+        posicao = procurar_indice_cidadao(tabela->indice_antigo, tabela->capacidade_antiga, chave);
+        if (posicao >= 0) {
+            tabela->indice_antigo[posicao].registro = registro;
         }
     }
-    return hash;
 }
 
 //Cria uma nova tabela hash para cidadãos
@@ -133,49 +391,83 @@ TabelaHashCidadaos* criar_tabela_cidadaos() {
     TabelaHashCidadaos* tabela = (TabelaHashCidadaos*)malloc(sizeof(TabelaHashCidadaos));
     if (!tabela) return NULL;
     
-    for (int i = 0; i < TAM_HASH; i++) {
-        tabela->tabela[i] = NULL;
+    tabela->indice = alocar_indice_cidadaos(TAM_HASH_INICIAL);
+    tabela->registros = (Cidadao*)malloc(TAM_HASH_INICIAL * sizeof(Cidadao));
+    if (!tabela->indice || !tabela->registros) {
+        free(tabela->indice);
+        free(tabela->registros);
+        free(tabela);
+        return NULL;
     }
+    tabela->capacidade = TAM_HASH_INICIAL;
+    tabela->indice_antigo = NULL;
+    tabela->capacidade_antiga = 0;
+    tabela->indice_migracao = 0;
+    tabela->capacidade_registros = TAM_HASH_INICIAL;
+    tabela->quantidade = 0;
     
     return tabela;
 }
 
+//Busca um cidadão pela chave do CPF já normalizada
+Cidadao* buscar_cidadao_chave(TabelaHashCidadaos* tabela, uint64_t chave) {
+    migrar_indice_cidadaos(tabela, BALDES_MIGRADOS_POR_OPERACAO);
+    
+    int posicao = posicao_indice_cidadao(tabela, chave);
+    if (posicao >= 0) return &tabela->registros[tabela->indice[posicao].registro];
+    
+    //Durante o rehash o cidadão ainda pode estar só no índice antigo
+    if (tabela->indice_antigo) {
+        posicao = procurar_indice_cidadao(tabela->indice_antigo, tabela->capacidade_antiga, chave);
+        if (posicao >= 0) return &tabela->registros[tabela->indice_antigo[posicao].registro];
+    }
+    
+    return NULL;
+}
+
 //Insere um cidadão na tabela hash
 int inserir_cidadao(TabelaHashCidadaos* tabela, const char* cpf, const char* nome, 
                    const char* email, const char* endereco, int bairro_id) {
     if (!tabela || !cpf || !nome || !email || !endereco) return 0;
     
-    //Verifica se já existe
-    if (buscar_cidadao(tabela, cpf)) return 0;
+    uint64_t chave;
+    if (!normalizar_cpf(cpf, &chave)) return 0;
     
-    int indice = hash_cpf(cpf);
-    Cidadao* novo = (Cidadao*)malloc(sizeof(Cidadao));
-    if (!novo) return 0;
+    //Verifica se já existe
+    if (buscar_cidadao_chave(tabela, chave)) return 0;
+    
+    //Garante espaço no vetor de registros e no índice
+    if (tabela->quantidade == tabela->capacidade_registros) {
+        Cidadao* registros = (Cidadao*)realloc(tabela->registros,
+                                               2 * tabela->capacidade_registros * sizeof(Cidadao));
+        if (!registros) return 0;
+        tabela->registros = registros;
+        tabela->capacidade_registros *= 2;
+    }
+    if (!crescer_indice_cidadaos(tabela)) return 0;
     
-    strcpy(novo->cpf, cpf);
-    strcpy(novo->nome, nome);
-    strcpy(novo->email, email);
-    strcpy(novo->endereco, endereco);
+    Cidadao* novo = &tabela->registros[tabela->quantidade];
+    novo->cpf = chave;
+    snprintf(novo->nome, sizeof(novo->nome), "%s", nome);
+    snprintf(novo->email, sizeof(novo->email), "%s", email);
+    snprintf(novo->endereco, sizeof(novo->endereco), "%s", endereco);
     novo->bairro_id = bairro_id;
-    novo->prox = tabela->tabela[indice];
-    tabela->tabela[indice] = novo;
+    
+    inserir_indice_cidadao(tabela, chave, tabela->quantidade);
+    tabela->quantidade++;
     
     return 1;
 }
 
 //Busca um cidadão pelo CPF
+//O ponteiro retornado aponta para o vetor de registros e vale até a próxima inserção ou remoção
 Cidadao* buscar_cidadao(TabelaHashCidadaos* tabela, const char* cpf) {
     if (!tabela || !cpf) return NULL;
     
-    int indice = hash_cpf(cpf);
-    Cidadao* atual = tabela->tabela[indice];
-    
-    while (atual) {
-        if (strcmp(atual->cpf, cpf) == 0) return atual;
-        atual = atual->prox;
-    }
+    uint64_t chave;
+    if (!normalizar_cpf(cpf, &chave)) return NULL;
     
-    return NULL;
+    return buscar_cidadao_chave(tabela, chave);
 }
 
 //Lista todos os cidadãos cadastrados
@@ -183,17 +475,14 @@ void listar_cidadaos(TabelaHashCidadaos* tabela) {
     if (!tabela) return;
     
     printf("\n=== CIDADÃOS CADASTRADOS ===\n");
-    int encontrou = 0;
-    for (int i = 0; i < TAM_HASH; i++) {
-        Cidadao* atual = tabela->tabela[i];
-        while (atual) {
-            printf("CPF: %s - Nome: %s - Email: %s\n", atual->cpf, atual->nome, atual->email);
-            printf("  Endereco: %s - Bairro ID: %d\n", atual->endereco, atual->bairro_id);
-            atual = atual->prox;
-            encontrou = 1;
-        }
+    for (int i = 0; i < tabela->quantidade; i++) {
+        Cidadao* atual = &tabela->registros[i];
+        char cpf[MAX_CPF];
+        formatar_cpf(atual->cpf, cpf);
+        printf("CPF: %s - Nome: %s - Email: %s\n", cpf, atual->nome, atual->email);
+        printf("  Endereco: %s - Bairro ID: %d\n", atual->endereco, atual->bairro_id);
     }
-    if (!encontrou) {
+    if (tabela->quantidade == 0) {
         printf("Nenhum cidadão cadastrado.\n");
     }
 }
@@ -202,156 +491,503 @@ void listar_cidadaos(TabelaHashCidadaos* tabela) {
 int remover_cidadao(TabelaHashCidadaos* tabela, const char* cpf) {
     if (!tabela || !cpf) return 0;
     
-    int indice = hash_cpf(cpf);
-    Cidadao* atual = tabela->tabela[indice];
-    Cidadao* anterior = NULL;
+    uint64_t chave;
+    if (!normalizar_cpf(cpf, &chave)) return 0;
     
-    while (atual) {
-        if (strcmp(atual->cpf, cpf) == 0) {
-            if (anterior == NULL) {
-                tabela->tabela[indice] = atual->prox;
-            } else {
-                anterior->prox = atual->prox;
-            }
-            free(atual);
-            return 1;
+    migrar_indice_cidadaos(tabela, BALDES_MIGRADOS_POR_OPERACAO);
+    
+    int registro = -1;
+    int posicao = posicao_indice_cidadao(tabela, chave);
+    if (posicao >= 0) {
+        registro = tabela->indice[posicao].registro;
+        int mascara = tabela->capacidade - 1;
+        
+        //Remoção com deslocamento para trás: puxa as entradas seguintes até achar vaga ou posição ideal
+        int proxima = (posicao + 1) & mascara;
+        while (tabela->indice[proxima].registro >= 0 && tabela->indice[proxima].distancia > 0) {
+            tabela->indice[posicao] = tabela->indice[proxima];
+            tabela->indice[posicao].distancia--;
+            posicao = proxima;
+            proxima = (proxima + 1) & mascara;
         }
-        anterior = atual;
-        atual = atual->prox;
+        tabela->indice[posicao].registro = ENTRADA_CIDADAO_VAZIA;
     }
     
-    return 0;
+    //No índice antigo vira lápide: deslocar entradas para trás as tiraria da frente da migração
+    if (tabela->indice_antigo) {
+        posicao = procurar_indice_cidadao(tabela->indice_antigo, tabela->capacidade_antiga, chave);
+        if (posicao >= 0) {
+            registro = tabela->indice_antigo[posicao].registro;
+            tabela->indice_antigo[posicao].registro = ENTRADA_CIDADAO_REMOVIDA;
+        }
+    }
+    if (registro < 0) return 0;
+    
+    //Mantém o vetor de registros compacto movendo o último para a vaga
+    int ultimo = --tabela->quantidade;
+    if (registro != ultimo) {
+        tabela->registros[registro] = tabela->registros[ultimo];
+        atualizar_registro_cidadao(tabela, tabela->registros[registro].cpf, registro);
+    }
+    
+    return 1;
 }
 
 //Libera memória da tabela de cidadãos
 void liberar_tabela_cidadaos(TabelaHashCidadaos* tabela) {
     if (!tabela) return;
     
-    for (int i = 0; i < TAM_HASH; i++) {
-        Cidadao* atual = tabela->tabela[i];
-        while (atual) {
-            Cidadao* temp = atual;
-            atual = atual->prox;
-            free(temp);
-        }
-    }
+    free(tabela->indice);
+    free(tabela->indice_antigo);
+    free(tabela->registros);
     free(tabela);
 }
 
-// ==================== IMPLEMENTAÇÃO - PILHAS DE HISTÓRICO ====================
-
-//Cria uma nova pilha de histórico
-PilhaHistorico* criar_pilha_historico() {
-    PilhaHistorico* pilha = (PilhaHistorico*)malloc(sizeof(PilhaHistorico));
-    if (!pilha) return NULL;
-    
-    pilha->topo = NULL;
-    pilha->tamanho = 0;
-    
-    return pilha;
-}
+#else
 
-//Verifica se a pilha está vazia
-int pilha_vazia(PilhaHistorico* pilha) {
-    return pilha == NULL || pilha->topo == NULL;
+//Aloca um vetor de baldes vazio
+Cidadao** alocar_baldes_cidadaos(int capacidade) {
+    return (Cidadao**)calloc(capacidade, sizeof(Cidadao*));
 }
 
-//Empilha um novo histórico de atendimento
-void empilhar_historico(PilhaHistorico* pilha, int ocorrencia_id, int bairro_id, 
-                       TipoServico tipo, int gravidade, int tempo_inicio, 
-                       int tempo_fim, const char* observacoes) {
-    if (!pilha) return;
-    
-    HistoricoAtendimento* novo = (HistoricoAtendimento*)malloc(sizeof(HistoricoAtendimento));
-    if (!novo) return;
+//Migra alguns baldes da tabela antiga para a atual (rehash incremental)
+void migrar_baldes_cidadaos(TabelaHashCidadaos* tabela, int baldes) {
+    if (!tabela->tabela_antiga) return;
     
-    novo->ocorrencia_id = ocorrencia_id;
-    novo->bairro_id = bairro_id;
-    novo->tipo_servico = tipo;
-    novo->gravidade = gravidade;
-    novo->tempo_inicio = tempo_inicio;
-    novo->tempo_fim = tempo_fim;
-    strcpy(novo->observacoes, observacoes ? observacoes : "Atendimento concluido");
-    novo->prox = pilha->topo;
+    while (baldes-- > 0 && tabela->indice_migracao < tabela->capacidade_antiga) {
+        Cidadao* atual = tabela->tabela_antiga[tabela->indice_migracao];
+        tabela->tabela_antiga[tabela->indice_migracao++] = NULL;
+        
+        while (atual) {
+            Cidadao* proximo = atual->prox;
+            size_t indice = hash_chave_cpf(atual->cpf) & (tabela->capacidade - 1);
+            atual->prox = tabela->tabela[indice];
+            tabela->tabela[indice] = atual;
+            atual = proximo;
+        }
+    }
     
-    pilha->topo = novo;
-    pilha->tamanho++;
+    //Terminou a migração: descarta a tabela antiga
+    if (tabela->indice_migracao >= tabela->capacidade_antiga) {
+        free(tabela->tabela_antiga);
+        tabela->tabela_antiga = NULL;
+        tabela->capacidade_antiga = 0;
+        tabela->indice_migracao = 0;
+    }
 }
 
-//Desempilha um histórico de atendimento
-HistoricoAtendimento* desempilhar_historico(PilhaHistorico* pilha) {
-    if (pilha_vazia(pilha)) return NULL;
+//Dobra a capacidade quando o fator de carga passa do limite
+//Os baldes antigos são migrados aos poucos nas operações seguintes
+void crescer_tabela_cidadaos(TabelaHashCidadaos* tabela) {
+    if (tabela->quantidade * 4 < tabela->capacidade * 3) return;
+    
+    //Se ainda havia migração pendente, conclui antes de iniciar outra
+    migrar_baldes_cidadaos(tabela, tabela->capacidade_antiga);
+    
+    Cidadao** nova = alocar_baldes_cidadaos(tabela->capacidade * 2);
+    if (!nova) return; //Sem memória: continua com a tabela atual
+    
+    tabela->tabela_antiga = tabela->tabela;
+    tabela->capacidade_antiga = tabela->capacidade;
+    tabela->indice_migracao = 0;
+    tabela->tabela = nova;
+    tabela->capacidade *= 2;
+}
+
+//Cria uma nova tabela hash para cidadãos
+TabelaHashCidadaos* criar_tabela_cidadaos() {
+    TabelaHashCidadaos* tabela = (TabelaHashCidadaos*)malloc(sizeof(TabelaHashCidadaos));
+    if (!tabela) return NULL;
     
-    HistoricoAtendimento* temp = pilha->topo;
-    pilha->topo = pilha->topo->prox;
-    pilha->tamanho--;
+    tabela->tabela = alocar_baldes_cidadaos(TAM_HASH_INICIAL);
+    if (!tabela->tabela) {
+        free(tabela);
+        return NULL;
+    }
+    tabela->capacidade = TAM_HASH_INICIAL;
+    tabela->tabela_antiga = NULL;
+    tabela->capacidade_antiga = 0;
+    tabela->indice_migracao = 0;
+    tabela->quantidade = 0;
     
-    return temp;
+    return tabela;
 }
 
-//Mostra o histórico completo (sem remover)
-void mostrar_historico(PilhaHistorico* pilha) {
-    if (pilha_vazia(pilha)) {
-        printf("Histórico vazio\n");
-        return;
-    }
+//Busca um cidadão pela chave do CPF já normalizada
+Cidadao* buscar_cidadao_chave(TabelaHashCidadaos* tabela, uint64_t chave) {
+    migrar_baldes_cidadaos(tabela, BALDES_MIGRADOS_POR_OPERACAO);
     
-    printf("Histórico (%d atendimentos):\n", pilha->tamanho);
-    HistoricoAtendimento* atual = pilha->topo;
-    int contador = 1;
+    uint64_t hash = hash_chave_cpf(chave);
+    Cidadao* atual = tabela->tabela[hash & (tabela->capacidade - 1)];
     
     while (atual) {
-        printf("  %d. Ocorrência #%d - %s - Bairro %d - Gravidade %d\n", 
-               contador++, atual->ocorrencia_id, tipo_servico_string(atual->tipo_servico),
-               atual->bairro_id, atual->gravidade);
-        printf("     Tempo: %d a %d - %s\n", 
-               atual->tempo_inicio, atual->tempo_fim, atual->observacoes);
+        if (atual->cpf == chave) return atual;
         atual = atual->prox;
     }
-}
-
-//Libera memória da pilha de histórico
-void liberar_pilha_historico(PilhaHistorico* pilha) {
-    if (!pilha) return;
     
-    while (!pilha_vazia(pilha)) {
-        HistoricoAtendimento* temp = desempilhar_historico(pilha);
-        free(temp);
+    //Durante o rehash o cidadão ainda pode estar em um balde não migrado
+    if (tabela->tabela_antiga) {
+        atual = tabela->tabela_antiga[hash & (tabela->capacidade_antiga - 1)];
+        while (atual) {
+            if (atual->cpf == chave) return atual;
+            atual = atual->prox;
+        }
     }
-    free(pilha);
-}
-
-// ==================== IMPLEMENTAÇÃO - LISTAS CRUZADAS ====================
-
-//Cria uma nova lista cruzada
-ListaCruzada* criar_lista_cruzada() {
-    ListaCruzada* lista = (ListaCruzada*)malloc(sizeof(ListaCruzada));
-    if (!lista) return NULL;
     
-    lista->primeiro = NULL;
-    return lista;
+    return NULL;
 }
 
-//Insere um bairro na lista cruzada
-int inserir_bairro_servico(ListaCruzada* lista, int bairro_id, const char* nome_bairro) {
-    if (!lista || !nome_bairro) return 0;
+//Insere um cidadão na tabela hash
+int inserir_cidadao(TabelaHashCidadaos* tabela, const char* cpf, const char* nome, 
+                   const char* email, const char* endereco, int bairro_id) {
+    if (!tabela || !cpf || !nome || !email || !endereco) return 0;
+    
+    //O CPF é normalizado uma única vez; daqui em diante só se compara a chave inteira
+    uint64_t chave;
+    if (!normalizar_cpf(cpf, &chave)) return 0;
     
     //Verifica se já existe
-    NoBairroServico* atual = lista->primeiro;
+    if (buscar_cidadao_chave(tabela, chave)) return 0;
+    
+    Cidadao* novo = (Cidadao*)malloc(sizeof(Cidadao));
+    if (!novo) return 0;
+    
+    crescer_tabela_cidadaos(tabela);
+    
+    size_t indice = hash_chave_cpf(chave) & (tabela->capacidade - 1);
+    novo->cpf = chave;
+    snprintf(novo->nome, sizeof(novo->nome), "%s", nome);
+    snprintf(novo->email, sizeof(novo->email), "%s", email);
+    snprintf(novo->endereco, sizeof(novo->endereco), "%s", endereco);
+    novo->bairro_id = bairro_id;
+    novo->prox = tabela->tabela[indice];
+    tabela->tabela[indice] = novo;
+    tabela->quantidade++;
+    
+    return 1;
+}
+
+//Busca um cidadão pelo CPF
+Cidadao* buscar_cidadao(TabelaHashCidadaos* tabela, const char* cpf) {
+    if (!tabela || !cpf) return NULL;
+    
+    uint64_t chave;
+    if (!normalizar_cpf(cpf, &chave)) return NULL;
+    
+    return buscar_cidadao_chave(tabela, chave);
+}
+
+//Mostra os cidadãos de um vetor de baldes
+int listar_baldes_cidadaos(Cidadao** baldes, int capacidade) {
+    int encontrou = 0;
+    for (int i = 0; i < capacidade; i++) {
+        Cidadao* atual = baldes[i];
+        while (atual) {
+            char cpf[MAX_CPF];
+            formatar_cpf(atual->cpf, cpf);
+            printf("CPF: %s - Nome: %s - Email: %s\n", cpf, atual->nome, atual->email);
+            printf("  Endereco: %s - Bairro ID: %d\n", atual->endereco, atual->bairro_id);
+            atual = atual->prox;
+            encontrou = 1;
+        }
+    }
+    return encontrou;
+}
+
+//Lista todos os cidadãos cadastrados
+void listar_cidadaos(TabelaHashCidadaos* tabela) {
+    if (!tabela) return;
+    
+    printf("\n=== CIDADÃOS CADASTRADOS ===\n");
+    int encontrou = 0;
+    if (tabela->tabela_antiga) {
+        encontrou = listar_baldes_cidadaos(tabela->tabela_antiga, tabela->capacidade_antiga);
+    }
+    encontrou |= listar_baldes_cidadaos(tabela->tabela, tabela->capacidade);
+    if (!encontrou) {
+        printf("Nenhum cidadão cadastrado.\n");
+    }
+}
+
+//Remove um cidadão de uma lista de colisões
+int remover_cidadao_balde(Cidadao** balde, uint64_t chave) {
+    Cidadao* atual = *balde;
+    Cidadao* anterior = NULL;
+    
+    while (atual) {
+        if (atual->cpf == chave) {
+            if (anterior == NULL) {
+                *balde = atual->prox;
+            } else {
+                anterior->prox = atual->prox;
+            }
+            free(atual);
+            return 1;
+        }
+        anterior = atual;
+        atual = atual->prox;
+    }
+    
+    return 0;
+}
+
+//Remove um cidadão da tabela hash
+int remover_cidadao(TabelaHashCidadaos* tabela, const char* cpf) {
+    if (!tabela || !cpf) return 0;
+    
+    uint64_t chave;
+    if (!normalizar_cpf(cpf, &chave)) return 0;
+    
+    migrar_baldes_cidadaos(tabela, BALDES_MIGRADOS_POR_OPERACAO);
+    
+    uint64_t hash = hash_chave_cpf(chave);
+    if (remover_cidadao_balde(&tabela->tabela[hash & (tabela->capacidade - 1)], chave) ||
+        (tabela->tabela_antiga &&
+         remover_cidadao_balde(&tabela->tabela_antiga[hash & (tabela->capacidade_antiga - 1)], chave))) {
+        tabela->quantidade--;
+        return 1;
+    }
+    
+    return 0;
+}
+
+//Libera os cidadãos de um vetor de baldes
+void liberar_baldes_cidadaos(Cidadao** baldes, int capacidade) {
+    for (int i = 0; i < capacidade; i++) {
+        Cidadao* atual = baldes[i];
+        while (atual) {
+            Cidadao* temp = atual;
+            atual = atual->prox;
+            free(temp);
+        }
+    }
+    free(baldes);
+}
+
+//Libera memória da tabela de cidadãos
+void liberar_tabela_cidadaos(TabelaHashCidadaos* tabela) {
+    if (!tabela) return;
+    
+    liberar_baldes_cidadaos(tabela->tabela, tabela->capacidade);
+    if (tabela->tabela_antiga) {
+        liberar_baldes_cidadaos(tabela->tabela_antiga, tabela->capacidade_antiga);
+    }
+    free(tabela);
+}
+
+#endif
+
+// ==================== IMPLEMENTAÇÃO - PILHAS DE HISTÓRICO ====================
+
+//Cria uma nova pilha de histórico
+PilhaHistorico* criar_pilha_historico() {
+    PilhaHistorico* pilha = (PilhaHistorico*)malloc(sizeof(PilhaHistorico));
+    if (!pilha) return NULL;
+    
+    pilha->topo = NULL;
+    pilha->tamanho = 0;
+    
+    return pilha;
+}
+
+//Verifica se a pilha está vazia
+int pilha_vazia(PilhaHistorico* pilha) {
+    return pilha == NULL || pilha->topo == NULL;
+}
+
+//Empilha um novo histórico de atendimento
+void empilhar_historico(PilhaHistorico* pilha, int ocorrencia_id, int bairro_id, 
+                       TipoServico tipo, int gravidade, int tempo_inicio, 
+                       int tempo_fim, const char* observacoes) {
+    if (!pilha) return;
+    
+    HistoricoAtendimento* novo = (HistoricoAtendimento*)malloc(sizeof(HistoricoAtendimento));
+    if (!novo) return;
+    
+    novo->ocorrencia_id = ocorrencia_id;
+    novo->bairro_id = bairro_id;
+    novo->tipo_servico = tipo;
+    novo->gravidade = gravidade;
+    novo->tempo_inicio = tempo_inicio;
+    novo->tempo_fim = tempo_fim;
+    snprintf(novo->observacoes, sizeof(novo->observacoes), "%s", observacoes ? observacoes : "Atendimento concluido");
+    novo->prox = pilha->topo;
+    
+    pilha->topo = novo;
+    pilha->tamanho++;
+}
+
+//Desempilha um histórico de atendimento
+HistoricoAtendimento* desempilhar_historico(PilhaHistorico* pilha) {
+    if (pilha_vazia(pilha)) return NULL;
+    
+    HistoricoAtendimento* temp = pilha->topo;
+    pilha->topo = pilha->topo->prox;
+    pilha->tamanho--;
+    
+    return temp;
+}
+
+//Mostra o histórico completo (sem remover)
+void mostrar_historico(PilhaHistorico* pilha) {
+    if (pilha_vazia(pilha)) {
+        printf("Histórico vazio\n");
+        return;
+    }
+    
+    printf("Histórico (%d atendimentos):\n", pilha->tamanho);
+    HistoricoAtendimento* atual = pilha->topo;
+    int contador = 1;
+    
     while (atual) {
-        if (atual->bairro_id == bairro_id) return 0;
-        atual = atual->prox_bairro;
+        printf("  %d. Ocorrência #%d - %s - Bairro %d - Gravidade %d\n", 
+               contador++, atual->ocorrencia_id, tipo_servico_string(atual->tipo_servico),
+               atual->bairro_id, atual->gravidade);
+        printf("     Tempo: %d a %d - %s\n", 
+               atual->tempo_inicio, atual->tempo_fim, atual->observacoes);
+        atual = atual->prox;
+    }
+}
+
+//Libera memória da pilha de histórico
+void liberar_pilha_historico(PilhaHistorico* pilha) {
+    if (!pilha) return;
+    
+    while (!pilha_vazia(pilha)) {
+        HistoricoAtendimento* temp = desempilhar_historico(pilha);
+        free(temp);
+    }
+    free(pilha);
+}
+
+// ==================== IMPLEMENTAÇÃO - LISTAS CRUZADAS ====================
+//Os contadores ficam numa matriz densa (uma coluna contígua por serviço, indexada pelo slot
+//do bairro) e o slot sai de um índice de endereçamento aberto por ID: atualizar é O(1).
+//Os nós bairro -> serviços continuam como visão cruzada, usada só para mostrar o mapa
+
+//Aloca um índice de slots com todas as entradas vazias
+EntradaSlotBairro* alocar_slots_bairros(int capacidade) {
+    EntradaSlotBairro* slots = (EntradaSlotBairro*)malloc(capacidade * sizeof(EntradaSlotBairro));
+    if (!slots) return NULL;
+    
+    for (int i = 0; i < capacidade; i++) {
+        slots[i].slot = -1;
+    }
+    return slots;
+}
+
+//Insere um ID no índice de slots (sondagem linear; o índice nunca fica cheio)
+void inserir_slot_bairro(ListaCruzada* lista, int bairro_id, int slot) {
+    int mascara = lista->capacidade_indice - 1;
+    int posicao = hash_bairro(bairro_id) & mascara;
+    
+    while (lista->indice[posicao].slot >= 0) {
+        posicao = (posicao + 1) & mascara;
+    }
+    
+    lista->indice[posicao].bairro_id = bairro_id;
+    lista->indice[posicao].slot = slot;
+}
+
+//Retorna o slot de um bairro na matriz, ou -1 se ele não está no mapa
+int slot_bairro_mapa(ListaCruzada* lista, int bairro_id) {
+    int mascara = lista->capacidade_indice - 1;
+    int posicao = hash_bairro(bairro_id) & mascara;
+    
+    while (lista->indice[posicao].slot >= 0) {
+        if (lista->indice[posicao].bairro_id == bairro_id) return lista->indice[posicao].slot;
+        posicao = (posicao + 1) & mascara;
+    }
+    
+    return -1;
+}
+
+//Garante espaço para mais um bairro: dobra a matriz quando os slots acabam
+//e o índice quando o fator de carga passa de 0,75
+int crescer_lista_cruzada(ListaCruzada* lista) {
+    if (lista->quantidade == lista->capacidade) {
+        int capacidade = lista->capacidade * 2;
+        
+        NoBairroServico** bairros = (NoBairroServico**)realloc(lista->bairros, capacidade * sizeof(NoBairroServico*));
+        if (!bairros) return 0;
+        lista->bairros = bairros;
+        
+        unsigned char* oferecidos = (unsigned char*)realloc(lista->servicos_oferecidos, capacidade);
+        if (!oferecidos) return 0;
+        lista->servicos_oferecidos = oferecidos;
+        
+        for (int t = 0; t < NUM_TIPOS_SERVICO; t++) {
+            int* coluna = (int*)realloc(lista->disponiveis[t], capacidade * sizeof(int));
+            if (!coluna) return 0;
+            
+            //Os slots novos começam zerados, então a soma de uma coluna pode passar deles
+            memset(coluna + lista->capacidade, 0, (capacidade - lista->capacidade) * sizeof(int));
+            lista->disponiveis[t] = coluna;
+        }
+        lista->capacidade = capacidade;
+    }
+    
+    if ((lista->quantidade + 1) * 4 >= lista->capacidade_indice * 3) {
+        EntradaSlotBairro* novo = alocar_slots_bairros(lista->capacidade_indice * 2);
+        if (!novo) return 0;
+        
+        free(lista->indice);
+        lista->indice = novo;
+        lista->capacidade_indice *= 2;
+        
+        for (int slot = 0; slot < lista->quantidade; slot++) {
+            inserir_slot_bairro(lista, lista->bairros[slot]->bairro_id, slot);
+        }
+    }
+    
+    return 1;
+}
+
+//Cria uma nova lista cruzada
+ListaCruzada* criar_lista_cruzada() {
+    ListaCruzada* lista = (ListaCruzada*)calloc(1, sizeof(ListaCruzada));
+    if (!lista) return NULL;
+    
+    lista->capacidade = MAPA_CAPACIDADE_INICIAL;
+    lista->capacidade_indice = MAPA_CAPACIDADE_INICIAL * 2;
+    lista->indice = alocar_slots_bairros(lista->capacidade_indice);
+    lista->bairros = (NoBairroServico**)malloc(lista->capacidade * sizeof(NoBairroServico*));
+    lista->servicos_oferecidos = (unsigned char*)calloc(lista->capacidade, 1);
+    int ok = lista->indice && lista->bairros && lista->servicos_oferecidos;
+    for (int t = 0; t < NUM_TIPOS_SERVICO; t++) {
+        lista->disponiveis[t] = (int*)calloc(lista->capacidade, sizeof(int));
+        ok = ok && lista->disponiveis[t];
+    }
+    
+    if (!ok) {
+        liberar_lista_cruzada(lista);
+        return NULL;
     }
+    return lista;
+}
+
+//Insere um bairro na lista cruzada
+int inserir_bairro_servico(ListaCruzada* lista, int bairro_id, const char* nome_bairro) {
+    if (!lista || !nome_bairro) return 0;
+    
+    //Verifica se já existe
+    if (slot_bairro_mapa(lista, bairro_id) >= 0) return 0;
+    if (!crescer_lista_cruzada(lista)) return 0;
     
     NoBairroServico* novo = (NoBairroServico*)malloc(sizeof(NoBairroServico));
     if (!novo) return 0;
     
     novo->bairro_id = bairro_id;
-    strcpy(novo->nome_bairro, nome_bairro);
+    novo->slot = lista->quantidade++;
+    snprintf(novo->nome_bairro, sizeof(novo->nome_bairro), "%s", nome_bairro);
     novo->servicos = NULL;
     novo->prox_bairro = lista->primeiro;
     lista->primeiro = novo;
     
+    lista->bairros[novo->slot] = novo;
+    lista->servicos_oferecidos[novo->slot] = 0;
+    inserir_slot_bairro(lista, bairro_id, novo->slot);
+    
     return 1;
 }
 
@@ -360,59 +996,75 @@ int adicionar_servico_bairro(ListaCruzada* lista, int bairro_id, TipoServico tip
     if (!lista) return 0;
     
     //Busca o bairro
-    NoBairroServico* bairro = lista->primeiro;
-    while (bairro && bairro->bairro_id != bairro_id) {
-        bairro = bairro->prox_bairro;
-    }
-    
-    if (!bairro) return 0;
+    int slot = slot_bairro_mapa(lista, bairro_id);
+    if (slot < 0) return 0;
     
-    //Verifica se o serviço já existe
-    NoServico* servico = bairro->servicos;
-    while (servico) {
-        if (servico->tipo == tipo) {
-            servico->unidades_disponiveis++;
-            return 1;
-        }
-        servico = servico->prox_servico;
+    //Serviço já oferecido: só ganha mais uma unidade
+    if (lista->servicos_oferecidos[slot] & (1u << tipo)) {
+        lista->disponiveis[tipo][slot]++;
+        return 1;
     }
     
-    //Cria novo serviço
+    //Cria o nó do serviço na visão cruzada
     NoServico* novo_servico = (NoServico*)malloc(sizeof(NoServico));
     if (!novo_servico) return 0;
     
+    NoBairroServico* bairro = lista->bairros[slot];
     novo_servico->tipo = tipo;
-    novo_servico->unidades_disponiveis = 1;
     novo_servico->prox_servico = bairro->servicos;
     bairro->servicos = novo_servico;
     
+    lista->servicos_oferecidos[slot] |= (unsigned char)(1u << tipo);
+    lista->disponiveis[tipo][slot] = 1;
+    
     return 1;
 }
 
 //Atualiza número de unidades disponíveis
+//Retorna 1 se atualizou e 0 se o bairro não oferece o serviço ou o contador ficaria negativo
 int atualizar_unidades_disponiveis(ListaCruzada* lista, int bairro_id, TipoServico tipo, int delta) {
     if (!lista) return 0;
     
-    NoBairroServico* bairro = lista->primeiro;
-    while (bairro && bairro->bairro_id != bairro_id) {
-        bairro = bairro->prox_bairro;
-    }
+    int slot = slot_bairro_mapa(lista, bairro_id);
+    if (slot < 0 || !(lista->servicos_oferecidos[slot] & (1u << tipo))) return 0;
     
-    if (!bairro) return 0;
+    //Sem unidade disponível no bairro não há o que descontar: o contador nunca fica negativo,
+    //e quem desconta guarda o bairro para devolver no mesmo lugar
+    int* contador = &lista->disponiveis[tipo][slot];
+    if (*contador + delta < 0) return 0;
+    *contador += delta;
+    return 1;
+}
+
+//Retorna as unidades disponíveis de um serviço em um bairro (0 se o bairro não oferece o serviço)
+int unidades_disponiveis_bairro(ListaCruzada* lista, int bairro_id, TipoServico tipo) {
+    if (!lista) return 0;
     
-    NoServico* servico = bairro->servicos;
-    while (servico) {
-        if (servico->tipo == tipo) {
-            servico->unidades_disponiveis += delta;
-            if (servico->unidades_disponiveis < 0) {
-                servico->unidades_disponiveis = 0;
-            }
-            return 1;
+    int slot = slot_bairro_mapa(lista, bairro_id);
+    return slot >= 0 ? lista->disponiveis[tipo][slot] : 0;
+}
+
+//Soma uma coluna da matriz: total de unidades disponíveis de um serviço na cidade
+//As parcelas são acumuladas em SOMA_COLUNA_LARGURA posições independentes, o que o compilador
+//transforma em instruções vetoriais; a capacidade é múltipla dessa largura e os slots livres valem 0
+int total_unidades_disponiveis(ListaCruzada* lista, TipoServico tipo) {
+    if (!lista) return 0;
+    
+    const int* coluna = lista->disponiveis[tipo];
+    int parciais[SOMA_COLUNA_LARGURA] = {0};
+    int limite = (lista->quantidade + SOMA_COLUNA_LARGURA - 1) / SOMA_COLUNA_LARGURA * SOMA_COLUNA_LARGURA;
+    
+    for (int i = 0; i < limite; i += SOMA_COLUNA_LARGURA) {
+        for (int j = 0; j < SOMA_COLUNA_LARGURA; j++) {
+            parciais[j] += coluna[i + j];
         }
-        servico = servico->prox_servico;
     }
     
-    return 0;
+    int total = 0;
+    for (int j = 0; j < SOMA_COLUNA_LARGURA; j++) {
+        total += parciais[j];
+    }
+    return total;
 }
 
 //Mostra o mapa da cidade com serviços
@@ -435,7 +1087,7 @@ void mostrar_mapa_cidade(ListaCruzada* lista) {
             while (servico) {
                 printf("%s: %d unidades disponíveis\n", 
                        tipo_servico_string(servico->tipo), 
-                       servico->unidades_disponiveis);
+                       lista->disponiveis[servico->tipo][bairro->slot]);
                 servico = servico->prox_servico;
             }
         }
@@ -443,6 +1095,12 @@ void mostrar_mapa_cidade(ListaCruzada* lista) {
         bairro = bairro->prox_bairro;
         printf("\n");
     }
+    
+    printf("Total disponível na cidade:");
+    for (int t = 0; t < NUM_TIPOS_SERVICO; t++) {
+        printf(" %s %d%s", tipo_servico_string((TipoServico)t),
+               total_unidades_disponiveis(lista, (TipoServico)t), t + 1 < NUM_TIPOS_SERVICO ? " |" : "\n");
+    }
 }
 
 //Libera memória da lista cruzada
@@ -463,48 +1121,172 @@ void liberar_lista_cruzada(ListaCruzada* lista) {
         free(bairro_temp);
     }
     
+    for (int t = 0; t < NUM_TIPOS_SERVICO; t++) {
+        free(lista->disponiveis[t]);
+    }
+    free(lista->servicos_oferecidos);
+    free(lista->bairros);
+    free(lista->indice);
     free(lista);
 }
 
 // ==================== IMPLEMENTAÇÃO - UNIDADES DE SERVIÇO ====================
 
-//Cria uma nova unidade de serviço
-UnidadeServico* criar_unidade(int id, TipoServico tipo, const char* identificacao) {
-    UnidadeServico* nova = (UnidadeServico*)malloc(sizeof(UnidadeServico));
-    if (!nova) return NULL;
-    
-    nova->id = id;
-    nova->tipo = tipo;
-    strcpy(nova->identificacao, identificacao);
-    nova->disponivel = 1;  //Inicialmente disponível
-    nova->prox = NULL;
+//Cria um registro de unidades vazio
+RegistroUnidades* criar_registro_unidades() {
+    RegistroUnidades* registro = (RegistroUnidades*)calloc(1, sizeof(RegistroUnidades));
+    if (!registro) return NULL;
+    
+    registro->capacidade = UNIDADES_CAPACIDADE_INICIAL;
+    registro->ids = (int*)malloc(registro->capacidade * sizeof(int));
+    registro->tipos = (unsigned char*)malloc(registro->capacidade);
+    registro->identificacoes = (char (*)[MAX_NOME])malloc(registro->capacidade * sizeof(*registro->identificacoes));
+    registro->bairros_mapa = (int*)malloc(registro->capacidade * sizeof(int));
+    int ok = registro->ids && registro->tipos && registro->identificacoes && registro->bairros_mapa;
+    for (int t = 0; t < NUM_TIPOS_SERVICO; t++) {
+        registro->livres[t] = (uint64_t*)calloc(registro->capacidade / 64, sizeof(uint64_t));
+        ok = ok && registro->livres[t];
+    }
     
-    return nova;
+    if (!ok) {
+        liberar_registro_unidades(registro);
+        return NULL;
+    }
+    return registro;
 }
 
-//Insere uma unidade na lista de unidades
-int inserir_unidade(UnidadeServico** lista, int id, TipoServico tipo, const char* identificacao) {
-    UnidadeServico* nova = criar_unidade(id, tipo, identificacao);
-    if (!nova) return 0;
+//Dobra os vetores do registro quando ele está cheio
+int crescer_registro_unidades(RegistroUnidades* registro) {
+    if (registro->quantidade < registro->capacidade) return 1;
+    
+    int capacidade = registro->capacidade * 2;
+    
+    int* ids = (int*)realloc(registro->ids, capacidade * sizeof(int));
+    if (!ids) return 0;
+    registro->ids = ids;
+    
+    unsigned char* tipos = (unsigned char*)realloc(registro->tipos, capacidade);
+    if (!tipos) return 0;
+    registro->tipos = tipos;
+    
+    char (*identificacoes)[MAX_NOME] = (char (*)[MAX_NOME])realloc(registro->identificacoes,
+                                                                 capacidade * sizeof(*identificacoes));
+    if (!identificacoes) return 0;
+    registro->identificacoes = identificacoes;
+    
+    int* bairros_mapa = (int*)realloc(registro->bairros_mapa, capacidade * sizeof(int));
+    if (!bairros_mapa) return 0;
+    registro->bairros_mapa = bairros_mapa;
+    
+    for (int t = 0; t < NUM_TIPOS_SERVICO; t++) {
+        uint64_t* livres = (uint64_t*)realloc(registro->livres[t], capacidade / 64 * sizeof(uint64_t));
+        if (!livres) return 0;
+        memset(livres + registro->capacidade / 64, 0, (capacidade - registro->capacidade) / 64 * sizeof(uint64_t));
+        registro->livres[t] = livres;
+    }
     
-    nova->prox = *lista;
-    *lista = nova;
+    registro->capacidade = capacidade;
+    return 1;
+}
+
+//Cadastra uma unidade no fim do registro; ela começa disponível
+int inserir_unidade(RegistroUnidades* registro, int id, TipoServico tipo, const char* identificacao) {
+    if (!registro || !identificacao) return 0;
+    if (!crescer_registro_unidades(registro)) return 0;
+    
+    int unidade = registro->quantidade++;
+    registro->ids[unidade] = id;
+    registro->tipos[unidade] = (unsigned char)tipo;
+    registro->unidades_por_tipo[tipo]++;
+    snprintf(registro->identificacoes[unidade], MAX_NOME, "%s", identificacao);
+    registro->bairros_mapa[unidade] = -1;
+    devolver_unidade_livre(registro, unidade);
     
     return 1;
 }
 
-//Busca uma unidade disponível do tipo especificado
-UnidadeServico* buscar_unidade_disponivel(UnidadeServico* lista, TipoServico tipo) {
-    UnidadeServico* atual = lista;
+//Retorna a posição do bit ligado menos significativo de uma palavra não nula (find-first-set)
+int primeiro_bit(uint64_t palavra) {
+#if defined(__GNUC__)
+    return __builtin_ctzll(palavra);
+#else
+    int posicao = 0;
+    while (!(palavra & 1)) {
+        palavra >>= 1;
+        posicao++;
+    }
+    return posicao;
+#endif
+}
+
+//Retorna a primeira unidade livre de um tipo (a de menor posição no cadastro), ou -1 se todas estão ocupadas
+//A busca começa na primeira palavra que pode ter bit ligado, então custa O(1) amortizado
+int primeira_unidade_livre(RegistroUnidades* registro, TipoServico tipo) {
+    if (!registro) return -1;
     
-    while (atual) {
-        if (atual->tipo == tipo && atual->disponivel) {
-            return atual;
-        }
-        atual = atual->prox;
+    uint64_t* livres = registro->livres[tipo];
+    int palavras = registro->capacidade / 64;
+    int palavra = registro->primeira_palavra[tipo];
+    
+    while (palavra < palavras && !livres[palavra]) {
+        palavra++;
     }
+    registro->primeira_palavra[tipo] = palavra;
     
-    return NULL;
+    return palavra < palavras ? palavra * 64 + primeiro_bit(livres[palavra]) : -1;
+}
+
+//Marca como ocupada e retorna a primeira unidade livre de um tipo, ou -1 se não houver
+int ocupar_unidade_livre(RegistroUnidades* registro, TipoServico tipo) {
+    int unidade = primeira_unidade_livre(registro, tipo);
+    if (unidade < 0) return -1;
+    
+    registro->livres[tipo][unidade / 64] &= ~((uint64_t)1 << (unidade % 64));
+    registro->livres_por_tipo[tipo]--;
+    return unidade;
+}
+
+//Marca uma unidade como disponível novamente: O(1)
+void devolver_unidade_livre(RegistroUnidades* registro, int unidade) {
+    if (!registro || unidade < 0 || unidade >= registro->quantidade) return;
+    
+    TipoServico tipo = (TipoServico)registro->tipos[unidade];
+    if (unidade_livre(registro, unidade)) return;
+    
+    registro->livres[tipo][unidade / 64] |= (uint64_t)1 << (unidade % 64);
+    registro->livres_por_tipo[tipo]++;
+    if (unidade / 64 < registro->primeira_palavra[tipo]) {
+        registro->primeira_palavra[tipo] = unidade / 64;
+    }
+}
+
+//Retorna 1 se a unidade está livre
+int unidade_livre(RegistroUnidades* registro, int unidade) {
+    return (registro->livres[registro->tipos[unidade]][unidade / 64] >> (unidade % 64)) & 1;
+}
+
+//Retorna quantas unidades de um tipo estão livres: O(1), pelo contador mantido ao ocupar e devolver
+int contar_unidades_livres(RegistroUnidades* registro, TipoServico tipo) {
+    if (!registro) return 0;
+    return registro->livres_por_tipo[tipo];
+}
+
+//Retorna quantas unidades de um tipo estão cadastradas: O(1), pelo contador mantido no cadastro
+int contar_unidades_tipo(RegistroUnidades* registro, TipoServico tipo) {
+    if (!registro) return 0;
+    return registro->unidades_por_tipo[tipo];
+}
+
+//Mostra, por tipo, quantas unidades existem e quantas estão livres
+void mostrar_resumo_frota(RegistroUnidades* registro) {
+    if (!registro) return;
+    
+    printf("Frota:");
+    for (int t = 0; t < NUM_TIPOS_SERVICO; t++) {
+        printf(" %s %d livres de %d%s", tipo_servico_string((TipoServico)t),
+               contar_unidades_livres(registro, (TipoServico)t),
+               contar_unidades_tipo(registro, (TipoServico)t), t + 1 < NUM_TIPOS_SERVICO ? " |" : "\n");
+    }
 }
 
 //Retorna string do tipo de serviço
@@ -518,32 +1300,221 @@ const char* tipo_servico_string(TipoServico tipo) {
 }
 
 //Lista todas as unidades cadastradas
-void listar_unidades(UnidadeServico* lista) {
+void listar_unidades(RegistroUnidades* registro) {
     printf("\n=== UNIDADES DE SERVIÇO ===\n");
-    UnidadeServico* atual = lista;
     
-    if (!atual) {
+    if (!registro || registro->quantidade == 0) {
         printf("Nenhuma unidade cadastrada.\n");
         return;
     }
     
-    while (atual) {
+    for (int i = 0; i < registro->quantidade; i++) {
         printf("ID: %d - %s - %s - Status: %s\n", 
-               atual->id, 
-               atual->identificacao,
-               tipo_servico_string(atual->tipo),
-               atual->disponivel ? "DISPONÍVEL" : "OCUPADO");
-        atual = atual->prox;
+               registro->ids[i], 
+               registro->identificacoes[i],
+               tipo_servico_string((TipoServico)registro->tipos[i]),
+               unidade_livre(registro, i) ? "DISPONÍVEL" : "OCUPADO");
     }
+    mostrar_resumo_frota(registro);
 }
 
 //Libera memória das unidades
-void liberar_unidades(UnidadeServico* lista) {
-    while (lista) {
-        UnidadeServico* temp = lista;
-        lista = lista->prox;
+void liberar_registro_unidades(RegistroUnidades* registro) {
+    if (!registro) return;
+    
+    for (int t = 0; t < NUM_TIPOS_SERVICO; t++) {
+        free(registro->livres[t]);
+    }
+    free(registro->bairros_mapa);
+    free(registro->identificacoes);
+    free(registro->tipos);
+    free(registro->ids);
+    free(registro);
+}
+
+// ==================== IMPLEMENTAÇÃO - CALENDÁRIO DE EVENTOS (HEAP MÍNIMO) ====================
+
+//Cria um calendário de eventos vazio
+CalendarioEventos* criar_calendario_eventos() {
+    CalendarioEventos* calendario = (CalendarioEventos*)malloc(sizeof(CalendarioEventos));
+    if (!calendario) return NULL;
+    
+    calendario->itens = (EventoSimulacao*)malloc(HEAP_CAPACIDADE_INICIAL * sizeof(EventoSimulacao));
+    if (!calendario->itens) {
+        free(calendario);
+        return NULL;
+    }
+    calendario->capacidade = HEAP_CAPACIDADE_INICIAL;
+    calendario->tamanho = 0;
+    calendario->proxima_sequencia = 0;
+    calendario->processados = 0;
+    for (int i = 0; i < NUM_TIPOS_SERVICO; i++) {
+        for (int j = 0; j <= ATRASO_DESPACHO; j++) {
+            calendario->despacho_agendado[i][j] = -1;
+        }
+    }
+    
+    return calendario;
+}
+
+//Monta um evento com os campos opcionais vazios (o chamador preenche os que o tipo usa)
+EventoSimulacao novo_evento(int tempo, TipoEvento tipo) {
+    EventoSimulacao evento;
+    
+    evento.tempo = tempo;
+    evento.tipo = tipo;
+    evento.sequencia = 0;
+    evento.ocorrencia_id = -1;
+    evento.unidade = -1;
+    evento.bairro_id = -1;
+    evento.servico = AMBULANCIA;
+    evento.gravidade = 0;
+    evento.tempo_inicio = -1;
+    
+    return evento;
+}
+
+//Retorna 1 se o evento a deve ser tratado antes do b: menor tempo, depois tipo, depois ordem de agendamento
+int evento_antes(const EventoSimulacao* a, const EventoSimulacao* b) {
+    if (a->tempo != b->tempo) return a->tempo < b->tempo;
+    if (a->tipo != b->tipo) return a->tipo < b->tipo;
+    return a->sequencia < b->sequencia;
+}
+
+//Garante espaço para mais quantidade eventos: depois dela, esses agendamentos não falham por memória
+int reservar_eventos(CalendarioEventos* calendario, int quantidade) {
+    if (!calendario || quantidade < 0) return 0;
+    
+    int capacidade = calendario->capacidade;
+    while (capacidade - calendario->tamanho < quantidade) capacidade *= 2;
+    if (capacidade == calendario->capacidade) return 1;
+    
+    EventoSimulacao* itens = (EventoSimulacao*)realloc(calendario->itens,
+                                    (size_t)capacidade * sizeof(EventoSimulacao));
+    if (!itens) return 0;
+    calendario->itens = itens;
+    calendario->capacidade = capacidade;
+    
+    return 1;
+}
+
+//Agenda um evento no calendário: O(log n)
+int agendar_evento(CalendarioEventos* calendario, EventoSimulacao evento) {
+    if (!calendario || evento.tempo < 0) return 0;
+    if (!reservar_eventos(calendario, 1)) return 0;
+    
+    evento.sequencia = calendario->proxima_sequencia++;
+    
+    //Sobe o novo evento enquanto ele vier antes do pai
+    int i = calendario->tamanho++;
+    while (i > 0 && evento_antes(&evento, &calendario->itens[(i - 1) / 2])) {
+        calendario->itens[i] = calendario->itens[(i - 1) / 2];
+        i = (i - 1) / 2;
+    }
+    calendario->itens[i] = evento;
+    
+    return 1;
+}
+
+//Retorna o tempo do próximo evento, ou -1 se o calendário estiver vazio
+int proximo_evento(CalendarioEventos* calendario) {
+    return (calendario && calendario->tamanho > 0) ? calendario->itens[0].tempo : -1;
+}
+
+//Remove e retorna o próximo evento: O(log n)
+EventoSimulacao retirar_evento(CalendarioEventos* calendario) {
+    EventoSimulacao primeiro = calendario->itens[0];
+    EventoSimulacao ultimo = calendario->itens[--calendario->tamanho];
+    
+    //Desce o último evento a partir da raiz até achar sua posição
+    int i = 0;
+    while (2 * i + 1 < calendario->tamanho) {
+        int filho = 2 * i + 1;
+        if (filho + 1 < calendario->tamanho &&
+            evento_antes(&calendario->itens[filho + 1], &calendario->itens[filho])) {
+            filho++;
+        }
+        if (!evento_antes(&calendario->itens[filho], &ultimo)) break;
+        calendario->itens[i] = calendario->itens[filho];
+        i = filho;
+    }
+    calendario->itens[i] = ultimo;
+    calendario->processados++;
+    
+    return primeiro;
+}
+
+//Libera memória do calendário
+void liberar_calendario_eventos(CalendarioEventos* calendario) {
+    if (!calendario) return;
+    
+    free(calendario->itens);
+    free(calendario);
+}
+
+// ==================== IMPLEMENTAÇÃO - POOLS DE MEMÓRIA ====================
+
+//Pools globais dos objetos pequenos criados a cada ocorrência (a fila circular não precisa de pool)
+PoolMemoria pool_ocorrencias = { sizeof(Ocorrencia), OBJETOS_POR_BLOCO, NULL, NULL, 0 };
+PoolMemoria pool_nos_bmais = { sizeof(NoArvoreBMais), OBJETOS_POR_BLOCO, NULL, NULL, 0 };
+
+//Quantidade de sistemas usando os pools (liberados em bloco quando o último termina)
+int sistemas_ativos = 0;
+
+//Aloca um novo bloco e encadeia todos os seus objetos na lista livre
+int pool_novo_bloco(PoolMemoria* pool) {
+    //Zerado para que campos que sobrevivem à reciclagem (ex.: geração da ocorrência) comecem definidos
+    BlocoPool* bloco = (BlocoPool*)calloc(1, sizeof(BlocoPool) + pool->tamanho_objeto * pool->objetos_por_bloco);
+    if (!bloco) return 0;
+    
+    bloco->prox = pool->blocos;
+    pool->blocos = bloco;
+    
+    char* objeto = (char*)(bloco + 1);
+    for (int i = 0; i < pool->objetos_por_bloco; i++) {
+        *(void**)objeto = pool->livres;
+        pool->livres = objeto;
+        objeto += pool->tamanho_objeto;
+    }
+    
+    return 1;
+}
+
+//Retira um objeto da lista livre (aloca um bloco novo se ela estiver vazia)
+void* pool_alocar(PoolMemoria* pool) {
+    if (!pool->livres && !pool_novo_bloco(pool)) return NULL;
+    
+    void* objeto = pool->livres;
+    pool->livres = *(void**)objeto;
+    pool->em_uso++;
+    
+    return objeto;
+}
+
+//Devolve um objeto para a lista livre do pool
+void pool_liberar(PoolMemoria* pool, void* objeto) {
+    if (!objeto) return;
+    
+    *(void**)objeto = pool->livres;
+    pool->livres = objeto;
+    pool->em_uso--;
+}
+
+//Libera todos os blocos do pool de uma vez
+void pool_destruir(PoolMemoria* pool) {
+    while (pool->blocos) {
+        BlocoPool* temp = pool->blocos;
+        pool->blocos = pool->blocos->prox;
         free(temp);
     }
+    pool->livres = NULL;
+    pool->em_uso = 0;
+}
+
+//Libera em bloco todos os pools globais
+void liberar_pools() {
+    pool_destruir(&pool_ocorrencias);
+    pool_destruir(&pool_nos_bmais);
 }
 
 // ==================== IMPLEMENTAÇÃO - FILAS ====================
@@ -553,8 +1524,14 @@ Fila* criar_fila() {
     Fila* fila = (Fila*)malloc(sizeof(Fila));
     if (!fila) return NULL;
     
-    fila->inicio = NULL;
-    fila->fim = NULL;
+    fila->itens = (HandleOcorrencia*)malloc(FILA_CAPACIDADE_INICIAL * sizeof(HandleOcorrencia));
+    if (!fila->itens) {
+        free(fila);
+        return NULL;
+    }
+    fila->capacidade = FILA_CAPACIDADE_INICIAL;
+    fila->inicio = 0;
+    fila->ocupados = 0;
     fila->tamanho = 0;
     
     return fila;
@@ -562,45 +1539,102 @@ Fila* criar_fila() {
 
 //Verifica se a fila está vazia
 int fila_vazia(Fila* fila) {
-    return fila == NULL || fila->inicio == NULL;
+    return fila == NULL || fila->tamanho == 0;
 }
 
-//Adiciona uma ocorrência na fila
-void enfileirar(Fila* fila, Ocorrencia* ocorrencia) {
-    if (!fila || !ocorrencia) return;
+//Dobra a capacidade do buffer circular, desenrolando os itens a partir da posição 0
+int crescer_fila(Fila* fila) {
+    HandleOcorrencia* novos = (HandleOcorrencia*)malloc(2 * fila->capacidade * sizeof(HandleOcorrencia));
+    if (!novos) return 0;
     
-    NoFila* novo = (NoFila*)malloc(sizeof(NoFila));
-    if (!novo) return;
+    int ate_o_fim = fila->capacidade - fila->inicio;
+    memcpy(novos, fila->itens + fila->inicio, ate_o_fim * sizeof(HandleOcorrencia));
+    memcpy(novos + ate_o_fim, fila->itens, fila->inicio * sizeof(HandleOcorrencia));
     
-    novo->ocorrencia = ocorrencia;
-    novo->prox = NULL;
+    free(fila->itens);
+    fila->itens = novos;
+    fila->inicio = 0;
+    fila->capacidade *= 2;
     
-    if (fila_vazia(fila)) {
-        fila->inicio = fila->fim = novo;
-    } else {
-        fila->fim->prox = novo;
-        fila->fim = novo;
-    }
+    return 1;
+}
+
+//Adiciona uma ocorrência na fila
+//Retorna 1 se enfileirou e 0 se o buffer não pôde crescer
+int enfileirar(Fila* fila, Ocorrencia* ocorrencia) {
+    if (!fila || !ocorrencia) return 0;
     
+    if (fila->ocupados == fila->capacidade && !crescer_fila(fila)) return 0;
+    
+    //A capacidade é potência de 2, então a volta do índice é uma máscara
+    fila->itens[(fila->inicio + fila->ocupados) & (fila->capacidade - 1)] = handle_ocorrencia(ocorrencia);
+    fila->ocupados++;
     fila->tamanho++;
+    
+    return 1;
 }
 
-//Remove e retorna a primeira ocorrência da fila
+//Remove e retorna a primeira ocorrência pendente da fila
+//Ocorrências que já saíram por outro caminho (ex.: despacho por prioridade ou remoção
+//do sistema, quando o handle deixa de valer) são descartadas aqui
 Ocorrencia* desenfileirar(Fila* fila) {
     if (fila_vazia(fila)) return NULL;
     
-    NoFila* temp = fila->inicio;
-    Ocorrencia* ocorrencia = temp->ocorrencia;
+    Ocorrencia* ocorrencia;
+    do {
+        ocorrencia = resolver_handle_ocorrencia(fila->itens[fila->inicio]);
+        fila->inicio = (fila->inicio + 1) & (fila->capacidade - 1);
+        fila->ocupados--;
+    } while (!ocorrencia || ocorrencia->estado != OCORRENCIA_PENDENTE);
+    fila->tamanho--;
+    podar_inicio_fila(fila, NULL);
     
-    fila->inicio = fila->inicio->prox;
-    if (fila->inicio == NULL) {
-        fila->fim = NULL;
+    return ocorrencia;
+}
+
+//Verifica se uma posição da fila ainda guarda uma ocorrência pendente (e não a que está saindo)
+int posicao_viva_fila(HandleOcorrencia handle, Ocorrencia* saindo) {
+    Ocorrencia* ocorrencia = resolver_handle_ocorrencia(handle);
+    return ocorrencia && ocorrencia != saindo && ocorrencia->estado == OCORRENCIA_PENDENTE;
+}
+
+//Descarta as lápides do início da fila, até a primeira ocorrência pendente
+void podar_inicio_fila(Fila* fila, Ocorrencia* saindo) {
+    while (fila->ocupados > 0 && !posicao_viva_fila(fila->itens[fila->inicio], saindo)) {
+        fila->inicio = (fila->inicio + 1) & (fila->capacidade - 1);
+        fila->ocupados--;
+    }
+    if (fila->ocupados == 0) {
+        fila->inicio = 0;
+    }
+}
+
+//Junta as ocorrências pendentes no começo do buffer, descartando todas as lápides
+//Cada posição é lida antes de ser sobrescrita, então a cópia é feita no próprio vetor
+void compactar_fila(Fila* fila, Ocorrencia* saindo) {
+    int mascara = fila->capacidade - 1;
+    int vivas = 0;
+    
+    for (int i = 0; i < fila->ocupados; i++) {
+        HandleOcorrencia handle = fila->itens[(fila->inicio + i) & mascara];
+        if (posicao_viva_fila(handle, saindo)) {
+            fila->itens[(fila->inicio + vivas++) & mascara] = handle;
+        }
     }
+    fila->ocupados = vivas;
+}
+
+//Retira da contagem uma ocorrência que deixou de estar pendente fora da ordem da fila
+//A posição dela vira uma lápide; as lápides do início saem na hora e, quando passam da metade
+//do buffer ocupado, a fila é compactada, então a memória acompanha as pendentes (O(1) amortizado)
+void descartar_da_fila(Fila* fila, Ocorrencia* saindo) {
+    if (fila_vazia(fila)) return;
     
-    free(temp);
     fila->tamanho--;
-    
-    return ocorrencia;
+    podar_inicio_fila(fila, saindo);
+    if (fila->ocupados > 2 * fila->tamanho) {
+        compactar_fila(fila, saindo);
+    }
 }
 
 //Mostra o conteúdo da fila
@@ -610,15 +1644,15 @@ void mostrar_fila(Fila* fila) {
         return;
     }
     
-    NoFila* atual = fila->inicio;
     printf("Fila (%d ocorrencias): ", fila->tamanho);
     
-    while (atual) {
+    for (int i = 0; i < fila->ocupados; i++) {
+        Ocorrencia* atual = resolver_handle_ocorrencia(fila->itens[(fila->inicio + i) & (fila->capacidade - 1)]);
+        if (!atual || atual->estado != OCORRENCIA_PENDENTE) continue;
         printf("[ID:%d Bairro:%d Grav:%d] ", 
-               atual->ocorrencia->id, 
-               atual->ocorrencia->bairro_id,
-               atual->ocorrencia->gravidade);
-        atual = atual->prox;
+               atual->id, 
+               atual->bairro_id,
+               atual->gravidade);
     }
     printf("\n");
 }
@@ -627,10 +1661,8 @@ void mostrar_fila(Fila* fila) {
 void liberar_fila(Fila* fila) {
     if (!fila) return;
     
-    while (!fila_vazia(fila)) {
-        Ocorrencia* ocorrencia = desenfileirar(fila);
-        free(ocorrencia);
-    }
+    //As ocorrências pertencem ao índice por ID; aqui só se libera o buffer
+    free(fila->itens);
     free(fila);
 }
 
@@ -638,225 +1670,854 @@ void liberar_fila(Fila* fila) {
 
 //Cria uma nova ocorrência
 Ocorrencia* criar_ocorrencia(int id, int bairro_id, TipoServico tipo, int gravidade, int tempo) {
-    Ocorrencia* nova = (Ocorrencia*)malloc(sizeof(Ocorrencia));
+    Ocorrencia* nova = (Ocorrencia*)pool_alocar(&pool_ocorrencias);
     if (!nova) return NULL;
     
     nova->id = id;
     nova->bairro_id = bairro_id;
     nova->tipo_servico = tipo;
-    nova->gravidade = gravidade;
+    //A gravidade é limitada uma vez aqui, ao ser guardada, e os dois índices de prioridade usam esse valor
+    nova->gravidade = gravidade < 1 ? 1 : (gravidade > NIVEIS_GRAVIDADE ? NIVEIS_GRAVIDADE : gravidade);
     nova->tempo_chegada = tempo;
+    nova->tempo_fim = -1;
+    nova->estado = OCORRENCIA_PENDENTE;
     nova->prox = NULL;
+    nova->ant = NULL;
     
     return nova;
 }
 
-// ==================== IMPLEMENTAÇÃO - ÁRVORE BST ====================
+//Devolve a ocorrência ao pool e invalida todos os handles que apontam para ela
+void liberar_ocorrencia(Ocorrencia* ocorrencia) {
+    if (!ocorrencia) return;
+    
+    //A geração fica fora do primeiro campo, que o pool usa para a lista livre
+    ocorrencia->geracao++;
+    pool_liberar(&pool_ocorrencias, ocorrencia);
+}
 
-//Cria uma nova árvore BST
-ArvoreBST* criar_arvore_bst() {
-    ArvoreBST* arvore = (ArvoreBST*)malloc(sizeof(ArvoreBST));
-    if (!arvore) return NULL;
+//Cria um handle para a ocorrência
+HandleOcorrencia handle_ocorrencia(Ocorrencia* ocorrencia) {
+    HandleOcorrencia handle;
+    handle.ocorrencia = ocorrencia;
+    handle.geracao = ocorrencia ? ocorrencia->geracao : 0;
+    return handle;
+}
+
+//Retorna a ocorrência do handle, ou NULL se ela já foi liberada
+//A memória continua no pool até o fim do sistema, então ler a geração é seguro
+Ocorrencia* resolver_handle_ocorrencia(HandleOcorrencia handle) {
+    if (!handle.ocorrencia || handle.ocorrencia->geracao != handle.geracao) return NULL;
+    return handle.ocorrencia;
+}
+
+//Mostra uma ocorrência em uma linha
+void mostrar_ocorrencia(Ocorrencia* ocorrencia) {
+    if (!ocorrencia) return;
+    
+    printf("ID: %d | Bairro: %d | %s | Gravidade: %d | Tempo: %d\n",
+           ocorrencia->id, ocorrencia->bairro_id,
+           tipo_servico_string(ocorrencia->tipo_servico),
+           ocorrencia->gravidade, ocorrencia->tempo_chegada);
+}
+
+// ==================== IMPLEMENTAÇÃO - ÍNDICE DE OCORRÊNCIAS ====================
+
+//Cria um índice de ocorrências vazio
+IndiceOcorrencias* criar_indice_ocorrencias() {
+    IndiceOcorrencias* indice = (IndiceOcorrencias*)malloc(sizeof(IndiceOcorrencias));
+    if (!indice) return NULL;
+    
+    indice->blocos = NULL;
+    indice->vivos = NULL;
+    indice->quantidade_blocos = 0;
+    indice->capacidade_blocos = 0;
+    indice->id_base = 0;
+    indice->tamanho = 0;
+    
+    return indice;
+}
+
+//Garante espaço no diretório de blocos para o bloco de número 'bloco'
+int reservar_blocos_indice(IndiceOcorrencias* indice, int bloco) {
+    if (bloco < indice->capacidade_blocos) return 1;
     
-    arvore->raiz = NULL;
-    arvore->tamanho = 0;
+    int nova_capacidade = indice->capacidade_blocos ? indice->capacidade_blocos : 4;
+    while (nova_capacidade <= bloco) nova_capacidade *= 2;
     
-    return arvore;
+    Ocorrencia*** blocos = (Ocorrencia***)realloc(indice->blocos, nova_capacidade * sizeof(Ocorrencia**));
+    if (!blocos) return 0;
+    indice->blocos = blocos;
+    
+    int* vivos = (int*)realloc(indice->vivos, nova_capacidade * sizeof(int));
+    if (!vivos) return 0;
+    indice->vivos = vivos;
+    
+    for (int i = indice->capacidade_blocos; i < nova_capacidade; i++) {
+        indice->blocos[i] = NULL;
+        indice->vivos[i] = 0;
+    }
+    indice->capacidade_blocos = nova_capacidade;
+    
+    return 1;
 }
 
-//Cria um novo nó para a árvore BST
-NoArvoreBST* criar_no_bst(Ocorrencia* ocorrencia) {
-    if (!ocorrencia) return NULL;
+//Indexa uma ocorrência pelo seu ID; o índice passa a ser o dono dela
+//Falha para IDs repetidos ou anteriores aos blocos já descartados
+int inserir_indice_ocorrencia(IndiceOcorrencias* indice, Ocorrencia* ocorrencia) {
+    if (!indice || !ocorrencia || ocorrencia->id < indice->id_base) return 0;
+    
+    int posicao = ocorrencia->id - indice->id_base;
+    int bloco = posicao / OCORRENCIAS_POR_BLOCO_INDICE;
+    if (!reservar_blocos_indice(indice, bloco)) return 0;
+    
+    if (!indice->blocos[bloco]) {
+        indice->blocos[bloco] = (Ocorrencia**)calloc(OCORRENCIAS_POR_BLOCO_INDICE, sizeof(Ocorrencia*));
+        if (!indice->blocos[bloco]) return 0;
+    }
     
-    NoArvoreBST* novo = (NoArvoreBST*)malloc(sizeof(NoArvoreBST));
-    if (!novo) return NULL;
+    Ocorrencia** slot = &indice->blocos[bloco][posicao & (OCORRENCIAS_POR_BLOCO_INDICE - 1)];
+    if (*slot) return 0;
     
-    //Cria uma cópia da ocorrência para evitar problemas de memória
-    novo->ocorrencia = (Ocorrencia*)malloc(sizeof(Ocorrencia));
-    if (!novo->ocorrencia) {
-        free(novo);
-        return NULL;
-    }
+    *slot = ocorrencia;
+    indice->vivos[bloco]++;
+    indice->tamanho++;
+    if (bloco >= indice->quantidade_blocos) indice->quantidade_blocos = bloco + 1;
     
-    *(novo->ocorrencia) = *ocorrencia; //Copia os dados
-    novo->esquerda = NULL;
-    novo->direita = NULL;
+    return 1;
+}
+
+//Busca uma ocorrência pelo ID em O(1)
+Ocorrencia* buscar_indice_ocorrencia(IndiceOcorrencias* indice, int id) {
+    if (!indice || id < indice->id_base) return NULL;
     
-    return novo;
+    int posicao = id - indice->id_base;
+    int bloco = posicao / OCORRENCIAS_POR_BLOCO_INDICE;
+    if (bloco >= indice->quantidade_blocos || !indice->blocos[bloco]) return NULL;
+    
+    return indice->blocos[bloco][posicao & (OCORRENCIAS_POR_BLOCO_INDICE - 1)];
 }
 
-//Insere uma ocorrência na árvore BST (ordenada por ID)
-int inserir_bst(ArvoreBST* arvore, Ocorrencia* ocorrencia) {
-    if (!arvore || !ocorrencia) return 0;
+//Remove e libera uma ocorrência; a posição fica vazia (lápide) e blocos
+//que esvaziam são devolvidos, deslizando a base quando são os mais antigos
+//Só remover_ocorrencia_sistema e desfazer_recebimento chamam esta função: elas tiram a ocorrência
+//antes da árvore de prioridades e das árvores B+, que guardam ponteiros. A fila e a lista de concluídas
+//guardam handles, que deixam de valer aqui mesmo que o pool reaproveite a memória para outra ocorrência
+int remover_indice_ocorrencia(IndiceOcorrencias* indice, int id) {
+    Ocorrencia* ocorrencia = buscar_indice_ocorrencia(indice, id);
+    if (!ocorrencia) return 0;
+    
+    int posicao = id - indice->id_base;
+    int bloco = posicao / OCORRENCIAS_POR_BLOCO_INDICE;
+    indice->blocos[bloco][posicao & (OCORRENCIAS_POR_BLOCO_INDICE - 1)] = NULL;
+    liberar_ocorrencia(ocorrencia);
+    indice->vivos[bloco]--;
+    indice->tamanho--;
+    
+    //O último bloco ainda recebe os próximos IDs, então é mantido
+    if (indice->vivos[bloco] == 0 && bloco < indice->quantidade_blocos - 1) {
+        free(indice->blocos[bloco]);
+        indice->blocos[bloco] = NULL;
+    }
     
-    if (arvore->raiz == NULL) {
-        arvore->raiz = criar_no_bst(ocorrencia);
-        if (arvore->raiz) {
-            arvore->tamanho++;
-            return 1;
+    int descartados = 0;
+    while (descartados < indice->quantidade_blocos - 1 && !indice->blocos[descartados]) {
+        descartados++;
+    }
+    if (descartados > 0) {
+        int restantes = indice->quantidade_blocos - descartados;
+        memmove(indice->blocos, indice->blocos + descartados, restantes * sizeof(Ocorrencia**));
+        memmove(indice->vivos, indice->vivos + descartados, restantes * sizeof(int));
+        for (int i = restantes; i < indice->quantidade_blocos; i++) {
+            indice->blocos[i] = NULL;
+            indice->vivos[i] = 0;
         }
-        return 0;
+        indice->quantidade_blocos = restantes;
+        indice->id_base += descartados * OCORRENCIAS_POR_BLOCO_INDICE;
     }
     
-    NoArvoreBST* atual = arvore->raiz;
-    NoArvoreBST* pai = NULL;
+    return 1;
+}
+
+//Mostra todas as ocorrências em ordem de ID (que também é a ordem de chegada)
+void mostrar_indice_ocorrencias(IndiceOcorrencias* indice) {
+    if (!indice || indice->tamanho == 0) {
+        printf("Nenhuma ocorrência cadastrada\n");
+        return;
+    }
     
-    //Busca a posição para inserção
-    while (atual != NULL) {
-        pai = atual;
-        if (ocorrencia->id < atual->ocorrencia->id) {
-            atual = atual->esquerda;
-        } else if (ocorrencia->id > atual->ocorrencia->id) {
-            atual = atual->direita;
-        } else {
-            //ID já existe, não insere
-            return 0;
+    for (int b = 0; b < indice->quantidade_blocos; b++) {
+        if (!indice->blocos[b]) continue;
+        for (int i = 0; i < OCORRENCIAS_POR_BLOCO_INDICE; i++) {
+            if (indice->blocos[b][i]) mostrar_ocorrencia(indice->blocos[b][i]);
         }
     }
+}
+
+//Mostra a organização do índice em blocos e as ocorrências indexadas
+void mostrar_estrutura_indice(IndiceOcorrencias* indice) {
+    if (!indice || indice->tamanho == 0) {
+        printf("Índice de ocorrências vazio\n");
+        return;
+    }
     
-    //Insere o novo nó
-    NoArvoreBST* novo = criar_no_bst(ocorrencia);
-    if (!novo) return 0;
+    int alocados = 0;
+    for (int b = 0; b < indice->quantidade_blocos; b++) {
+        if (indice->blocos[b]) alocados++;
+    }
     
-    if (ocorrencia->id < pai->ocorrencia->id) {
-        pai->esquerda = novo;
-    } else {
-        pai->direita = novo;
+    printf("\n=== ÍNDICE POR ID - OCORRÊNCIAS ===\n");
+    printf("Total de ocorrências: %d\n", indice->tamanho);
+    printf("Blocos alocados: %d de %d (%d posições cada, a partir do ID %d)\n",
+           alocados, indice->quantidade_blocos, OCORRENCIAS_POR_BLOCO_INDICE, indice->id_base);
+    printf("Ocorrências ordenadas por ID:\n");
+    mostrar_indice_ocorrencias(indice);
+}
+
+//Libera o índice e todas as ocorrências que ainda estão nele
+void liberar_indice_ocorrencias(IndiceOcorrencias* indice) {
+    if (!indice) return;
+    
+    for (int b = 0; b < indice->quantidade_blocos; b++) {
+        if (!indice->blocos[b]) continue;
+        for (int i = 0; i < OCORRENCIAS_POR_BLOCO_INDICE; i++) {
+            if (indice->blocos[b][i]) liberar_ocorrencia(indice->blocos[b][i]);
+        }
+        free(indice->blocos[b]);
+    }
+    free(indice->blocos);
+    free(indice->vivos);
+    free(indice);
+}
+
+// ==================== IMPLEMENTAÇÃO - ARQUIVO DE OCORRÊNCIAS ====================
+
+//Cria um arquivo vazio, com a retenção desligada (nada sai dos índices vivos)
+ArquivoOcorrencias* criar_arquivo_ocorrencias() {
+    ArquivoOcorrencias* arquivo = (ArquivoOcorrencias*)calloc(1, sizeof(ArquivoOcorrencias));
+    if (!arquivo) return NULL;
+    
+    arquivo->concluidas = (HandleOcorrencia*)malloc(ARQUIVO_CAPACIDADE_INICIAL * sizeof(HandleOcorrencia));
+    if (!arquivo->concluidas) {
+        free(arquivo);
+        return NULL;
     }
+    arquivo->capacidade_concluidas = ARQUIVO_CAPACIDADE_INICIAL;
+    arquivo->idade_maxima = RETENCAO_DESLIGADA;
+    arquivo->maximo_concluidas = RETENCAO_DESLIGADA;
     
-    arvore->tamanho++;
-    return 1;
+    return arquivo;
 }
 
-//Busca um nó na árvore BST por ID
-NoArvoreBST* buscar_bst(ArvoreBST* arvore, int id) {
-    if (!arvore) return NULL;
+//Dobra a fila circular de concluídas, desenrolando os itens a partir da posição 0
+int crescer_concluidas(ArquivoOcorrencias* arquivo) {
+    HandleOcorrencia* novos = (HandleOcorrencia*)malloc(2 * arquivo->capacidade_concluidas * sizeof(HandleOcorrencia));
+    if (!novos) return 0;
     
-    NoArvoreBST* atual = arvore->raiz;
+    int ate_o_fim = arquivo->capacidade_concluidas - arquivo->inicio_concluidas;
+    memcpy(novos, arquivo->concluidas + arquivo->inicio_concluidas, ate_o_fim * sizeof(HandleOcorrencia));
+    memcpy(novos + ate_o_fim, arquivo->concluidas, arquivo->inicio_concluidas * sizeof(HandleOcorrencia));
     
-    while (atual != NULL) {
-        if (id == atual->ocorrencia->id) {
-            return atual;
-        } else if (id < atual->ocorrencia->id) {
-            atual = atual->esquerda;
-        } else {
-            atual = atual->direita;
-        }
-    }
+    free(arquivo->concluidas);
+    arquivo->concluidas = novos;
+    arquivo->inicio_concluidas = 0;
+    arquivo->capacidade_concluidas *= 2;
     
-    return NULL;
+    return 1;
 }
 
-//Busca uma ocorrência por ID e retorna a ocorrência
-Ocorrencia* buscar_ocorrencia_por_id(ArvoreBST* arvore, int id) {
-    NoArvoreBST* no = buscar_bst(arvore, id);
-    return no ? no->ocorrencia : NULL;
+//Anota uma ocorrência que acabou de ser concluída (ainda nos índices vivos)
+int registrar_concluida(ArquivoOcorrencias* arquivo, Ocorrencia* ocorrencia) {
+    if (!arquivo || !ocorrencia) return 0;
+    
+    if (arquivo->ocupadas_concluidas == arquivo->capacidade_concluidas && !crescer_concluidas(arquivo)) return 0;
+    
+    int posicao = (arquivo->inicio_concluidas + arquivo->ocupadas_concluidas) & (arquivo->capacidade_concluidas - 1);
+    arquivo->concluidas[posicao] = handle_ocorrencia(ocorrencia);
+    arquivo->ocupadas_concluidas++;
+    arquivo->concluidas_vivas++;
+    return 1;
 }
 
-//Percorre a árvore em ordem (esquerda, raiz, direita)
-void percorrer_em_ordem_bst(NoArvoreBST* no) {
-    if (no != NULL) {
-        percorrer_em_ordem_bst(no->esquerda);
-        printf("ID: %d | Bairro: %d | %s | Gravidade: %d | Tempo: %d\n",
-               no->ocorrencia->id, no->ocorrencia->bairro_id,
-               tipo_servico_string(no->ocorrencia->tipo_servico),
-               no->ocorrencia->gravidade, no->ocorrencia->tempo_chegada);
-        percorrer_em_ordem_bst(no->direita);
+//Retorna a concluída mais antiga ainda nos índices vivos, sem retirá-la
+//Handles de ocorrências removidas por outro caminho são descartados aqui
+Ocorrencia* primeira_concluida(ArquivoOcorrencias* arquivo) {
+    while (arquivo->ocupadas_concluidas > 0) {
+        Ocorrencia* ocorrencia = resolver_handle_ocorrencia(arquivo->concluidas[arquivo->inicio_concluidas]);
+        if (ocorrencia) return ocorrencia;
+        descartar_primeira_concluida(arquivo);
     }
+    return NULL;
 }
 
-//Percorre a árvore em pré-ordem (raiz, esquerda, direita)
-void percorrer_pre_ordem_bst(NoArvoreBST* no) {
-    if (no != NULL) {
-        printf("ID: %d | Bairro: %d | %s | Gravidade: %d | Tempo: %d\n",
-               no->ocorrencia->id, no->ocorrencia->bairro_id,
-               tipo_servico_string(no->ocorrencia->tipo_servico),
-               no->ocorrencia->gravidade, no->ocorrencia->tempo_chegada);
-        percorrer_pre_ordem_bst(no->esquerda);
-        percorrer_pre_ordem_bst(no->direita);
-    }
+//Retira a primeira posição da fila de concluídas
+void descartar_primeira_concluida(ArquivoOcorrencias* arquivo) {
+    if (arquivo->ocupadas_concluidas == 0) return;
+    
+    arquivo->inicio_concluidas = (arquivo->inicio_concluidas + 1) & (arquivo->capacidade_concluidas - 1);
+    arquivo->ocupadas_concluidas--;
 }
 
-//Percorre a árvore em pós-ordem (esquerda, direita, raiz)
-void percorrer_pos_ordem_bst(NoArvoreBST* no) {
-    if (no != NULL) {
-        percorrer_pos_ordem_bst(no->esquerda);
-        percorrer_pos_ordem_bst(no->direita);
-        printf("ID: %d | Bairro: %d | %s | Gravidade: %d | Tempo: %d\n",
-               no->ocorrencia->id, no->ocorrencia->bairro_id,
-               tipo_servico_string(no->ocorrencia->tipo_servico),
-               no->ocorrencia->gravidade, no->ocorrencia->tempo_chegada);
+//Verifica se a política de retenção manda arquivar a concluída mais antiga
+int retencao_expirou(ArquivoOcorrencias* arquivo, Ocorrencia* ocorrencia, int tempo_atual) {
+    if (arquivo->maximo_concluidas != RETENCAO_DESLIGADA &&
+        arquivo->concluidas_vivas > arquivo->maximo_concluidas) {
+        return 1;
     }
+    return arquivo->idade_maxima != RETENCAO_DESLIGADA &&
+           tempo_atual - ocorrencia->tempo_fim >= arquivo->idade_maxima;
 }
 
-//Mostra informações gerais da árvore BST
-void mostrar_arvore_bst(ArvoreBST* arvore) {
-    if (!arvore || !arvore->raiz) {
-        printf("Árvore BST vazia\n");
-        return;
+//Acrescenta o registro compacto de uma ocorrência concluída ao fim do arquivo
+int arquivar_ocorrencia(ArquivoOcorrencias* arquivo, Ocorrencia* ocorrencia) {
+    if (!arquivo || !ocorrencia || ocorrencia->id < 0) return 0;
+    
+    if (arquivo->quantidade == arquivo->capacidade) {
+        int capacidade = arquivo->capacidade ? 2 * arquivo->capacidade : ARQUIVO_CAPACIDADE_INICIAL;
+        OcorrenciaArquivada* registros = (OcorrenciaArquivada*)realloc(arquivo->registros,
+                                               capacidade * sizeof(OcorrenciaArquivada));
+        if (!registros) return 0;
+        arquivo->registros = registros;
+        arquivo->capacidade = capacidade;
     }
     
-    printf("\n=== ÁRVORE BST - OCORRÊNCIAS ===\n");
-    printf("Total de ocorrências: %d\n", arvore->tamanho);
-    printf("Ocorrências ordenadas por ID:\n");
-    percorrer_em_ordem_bst(arvore->raiz);
+    if (ocorrencia->id >= arquivo->capacidade_posicoes) {
+        int capacidade = arquivo->capacidade_posicoes ? arquivo->capacidade_posicoes : ARQUIVO_CAPACIDADE_INICIAL;
+        while (capacidade <= ocorrencia->id) capacidade *= 2;
+        int* posicoes = (int*)realloc(arquivo->posicoes, capacidade * sizeof(int));
+        if (!posicoes) return 0;
+        for (int i = arquivo->capacidade_posicoes; i < capacidade; i++) {
+            posicoes[i] = -1;
+        }
+        arquivo->posicoes = posicoes;
+        arquivo->capacidade_posicoes = capacidade;
+    }
+    
+    OcorrenciaArquivada* registro = &arquivo->registros[arquivo->quantidade];
+    registro->id = ocorrencia->id;
+    registro->bairro_id = ocorrencia->bairro_id;
+    registro->tempo_chegada = ocorrencia->tempo_chegada;
+    registro->tempo_fim = ocorrencia->tempo_fim;
+    registro->tipo_servico = (unsigned char)ocorrencia->tipo_servico;
+    registro->gravidade = (unsigned char)ocorrencia->gravidade;
+    arquivo->posicoes[ocorrencia->id] = arquivo->quantidade++;
+    
+    return 1;
 }
 
-//Mostra árvore ordenada por ID (em ordem)
-void mostrar_arvore_ordenada_por_id(ArvoreBST* arvore) {
-    if (!arvore || !arvore->raiz) {
-        printf("Nenhuma ocorrência cadastrada na árvore\n");
-        return;
-    }
+//Busca o registro arquivado de um ID em O(1)
+OcorrenciaArquivada* buscar_arquivo_ocorrencia(ArquivoOcorrencias* arquivo, int id) {
+    if (!arquivo || id < 0 || id >= arquivo->capacidade_posicoes || arquivo->posicoes[id] < 0) return NULL;
     
-    printf("\n=== CONSULTA ORDENADA POR ID ===\n");
-    percorrer_em_ordem_bst(arvore->raiz);
+    return &arquivo->registros[arquivo->posicoes[id]];
 }
 
-//Mostra árvore ordenada por tempo (pré-ordem)
-void mostrar_arvore_ordenada_por_tempo(ArvoreBST* arvore) {
-    if (!arvore || !arvore->raiz) {
+//Retorna a posição do primeiro registro com tempo_fim >= tempo (busca binária)
+int primeira_posicao_arquivo(ArquivoOcorrencias* arquivo, int tempo_fim) {
+    int inicio = 0, fim = arquivo->quantidade;
+    
+    while (inicio < fim) {
+        int meio = inicio + (fim - inicio) / 2;
+        if (arquivo->registros[meio].tempo_fim < tempo_fim) {
+            inicio = meio + 1;
+        } else {
+            fim = meio;
+        }
+    }
+    
+    return inicio;
+}
+
+//Mostra um registro arquivado em uma linha
+void mostrar_ocorrencia_arquivada(OcorrenciaArquivada* registro) {
+    if (!registro) return;
+    
+    printf("ID: %d | Bairro: %d | %s | Gravidade: %d | Tempo: %d | Fim: %d\n",
+           registro->id, registro->bairro_id, tipo_servico_string((TipoServico)registro->tipo_servico),
+           registro->gravidade, registro->tempo_chegada, registro->tempo_fim);
+}
+
+//Mostra as ocorrências arquivadas que terminaram entre de e ate (inclusive)
+//Retorna quantas foram mostradas
+int mostrar_faixa_arquivo(ArquivoOcorrencias* arquivo, int de, int ate) {
+    if (!arquivo) return 0;
+    
+    int total = 0;
+    for (int i = primeira_posicao_arquivo(arquivo, de);
+         i < arquivo->quantidade && arquivo->registros[i].tempo_fim <= ate; i++) {
+        mostrar_ocorrencia_arquivada(&arquivo->registros[i]);
+        total++;
+    }
+    printf("Total arquivado com fim em %d..%d: %d\n", de, ate, total);
+    
+    return total;
+}
+
+//Mostra o tamanho do arquivo e a política de retenção em uso
+void mostrar_resumo_arquivo(ArquivoOcorrencias* arquivo) {
+    if (!arquivo) return;
+    
+    printf("\n=== ARQUIVO DE OCORRÊNCIAS CONCLUÍDAS ===\n");
+    if (arquivo->idade_maxima == RETENCAO_DESLIGADA) {
+        printf("Idade máxima nos índices: sem limite\n");
+    } else {
+        printf("Idade máxima nos índices: %d unidades de tempo após o fim\n", arquivo->idade_maxima);
+    }
+    if (arquivo->maximo_concluidas == RETENCAO_DESLIGADA) {
+        printf("Máximo de concluídas nos índices: sem limite\n");
+    } else {
+        printf("Máximo de concluídas nos índices: %d\n", arquivo->maximo_concluidas);
+    }
+    printf("Concluídas ainda nos índices: %d\n", arquivo->concluidas_vivas);
+    printf("Ocorrências arquivadas: %d (%zu bytes por registro)\n",
+           arquivo->quantidade, sizeof(OcorrenciaArquivada));
+    if (arquivo->quantidade > 0) {
+        printf("Fim do atendimento entre %d e %d\n",
+               arquivo->registros[0].tempo_fim, arquivo->registros[arquivo->quantidade - 1].tempo_fim);
+    }
+}
+
+//Libera o arquivo
+void liberar_arquivo_ocorrencias(ArquivoOcorrencias* arquivo) {
+    if (!arquivo) return;
+    
+    free(arquivo->registros);
+    free(arquivo->posicoes);
+    free(arquivo->concluidas);
+    free(arquivo);
+}
+
+// ==================== IMPLEMENTAÇÃO - HISTOGRAMAS DE LATÊNCIA ====================
+
+//Retorna o balde de um valor em O(1): exato abaixo de 2^BITS_EXATOS_HISTOGRAMA e, acima,
+//a potência de 2 do valor mais os BITS_SUBBALDES_HISTOGRAMA bits seguintes ao mais alto
+int balde_histograma(int valor) {
+    if (valor < 0) valor = 0;
+    if (valor < (1 << BITS_EXATOS_HISTOGRAMA)) return valor;
+    
+#if defined(__GNUC__)
+    int mais_alto = 31 - __builtin_clz((unsigned int)valor);
+#else
+    int mais_alto = BITS_EXATOS_HISTOGRAMA;
+    while (valor >> (mais_alto + 1)) mais_alto++;
+#endif
+    int deslocamento = mais_alto - BITS_SUBBALDES_HISTOGRAMA;
+    int subbalde = (valor >> deslocamento) - (1 << BITS_SUBBALDES_HISTOGRAMA);
+    return (1 << BITS_EXATOS_HISTOGRAMA) +
+           ((mais_alto - BITS_EXATOS_HISTOGRAMA) << BITS_SUBBALDES_HISTOGRAMA) + subbalde;
+}
+
+//Retorna o maior valor que cai em um balde
+int maior_valor_balde_histograma(int balde) {
+    if (balde < (1 << BITS_EXATOS_HISTOGRAMA)) return balde;
+    
+    int potencia = (balde - (1 << BITS_EXATOS_HISTOGRAMA)) >> BITS_SUBBALDES_HISTOGRAMA;
+    int subbalde = (balde - (1 << BITS_EXATOS_HISTOGRAMA)) & ((1 << BITS_SUBBALDES_HISTOGRAMA) - 1);
+    int deslocamento = potencia + BITS_EXATOS_HISTOGRAMA - BITS_SUBBALDES_HISTOGRAMA;
+    long long menor = (long long)((1 << BITS_SUBBALDES_HISTOGRAMA) + subbalde) << deslocamento;
+    return (int)(menor + (1LL << deslocamento) - 1);
+}
+
+//Conta um valor no histograma: O(1)
+void registrar_histograma(HistogramaLatencia* histograma, int valor) {
+    if (!histograma) return;
+    if (valor < 0) valor = 0;
+    
+    histograma->contagens[balde_histograma(valor)]++;
+    histograma->total++;
+    histograma->soma += valor;
+    if (valor > histograma->maximo) histograma->maximo = valor;
+}
+
+//Retorna o valor abaixo do qual (ou igual) está o percentil pedido (0 a 100) das amostras
+//O resultado é o maior valor do balde, limitado ao máximo visto; 0 se o histograma está vazio
+int percentil_histograma(HistogramaLatencia* histograma, double percentil) {
+    if (!histograma || histograma->total == 0) return 0;
+    
+    //Multiplica antes de dividir: com percentis inteiros a posição exata não sofre arredondamento
+    long long alvo = (long long)ceil(percentil * histograma->total / 100.0);
+    if (alvo < 1) alvo = 1;
+    
+    long long acumulado = 0;
+    for (int balde = 0; balde < BALDES_HISTOGRAMA; balde++) {
+        acumulado += histograma->contagens[balde];
+        if (acumulado >= alvo) {
+            int valor = maior_valor_balde_histograma(balde);
+            return valor < histograma->maximo ? valor : histograma->maximo;
+        }
+    }
+    return histograma->maximo;
+}
+
+//Cria um painel de latências vazio; os histogramas dos bairros são criados conforme aparecem
+PainelLatencias* criar_painel_latencias() {
+    PainelLatencias* painel = (PainelLatencias*)calloc(1, sizeof(PainelLatencias));
+    return painel;
+}
+
+//Retorna os histogramas do bairro em um slot do mapa, aumentando o vetor se for preciso
+LatenciasAtendimento* latencias_do_bairro(PainelLatencias* painel, int slot) {
+    if (!painel || slot < 0) return NULL;
+    
+    if (slot >= painel->capacidade_bairros) {
+        int capacidade = painel->capacidade_bairros ? painel->capacidade_bairros : MAPA_CAPACIDADE_INICIAL;
+        while (capacidade <= slot) capacidade *= 2;
+        
+        LatenciasAtendimento* por_bairro = (LatenciasAtendimento*)realloc(painel->por_bairro,
+                                                                         capacidade * sizeof(LatenciasAtendimento));
+        if (!por_bairro) return NULL;
+        memset(por_bairro + painel->capacidade_bairros, 0,
+               (capacidade - painel->capacidade_bairros) * sizeof(LatenciasAtendimento));
+        painel->por_bairro = por_bairro;
+        painel->capacidade_bairros = capacidade;
+    }
+    
+    return &painel->por_bairro[slot];
+}
+
+//Registra a espera de um atendimento no serviço e no bairro: O(1)
+void registrar_latencias(PainelLatencias* painel, TipoServico tipo, int slot_bairro, int espera) {
+    if (!painel) return;
+    
+    registrar_histograma(&painel->por_servico[tipo].espera, espera);
+    
+    LatenciasAtendimento* bairro = latencias_do_bairro(painel, slot_bairro);
+    if (bairro) {
+        registrar_histograma(&bairro->espera, espera);
+    }
+}
+
+//Registra a duração real de um atendimento concluído no serviço e no bairro: O(1)
+void registrar_duracao_atendimento(PainelLatencias* painel, TipoServico tipo, int slot_bairro, int duracao) {
+    if (!painel) return;
+    
+    registrar_histograma(&painel->por_servico[tipo].servico, duracao);
+    
+    LatenciasAtendimento* bairro = latencias_do_bairro(painel, slot_bairro);
+    if (bairro) {
+        registrar_histograma(&bairro->servico, duracao);
+    }
+}
+
+//Mostra os percentis de um histograma em uma linha
+void mostrar_histograma(const char* nome, HistogramaLatencia* histograma) {
+    printf("%s: ", nome);
+    if (histograma->total == 0) {
+        printf("sem atendimentos\n");
+        return;
+    }
+    printf("p50 %d | p90 %d | p99 %d | máx %d | média %.2f (%lld atendimentos)\n",
+           percentil_histograma(histograma, 50), percentil_histograma(histograma, 90),
+           percentil_histograma(histograma, 99), histograma->maximo,
+           (double)histograma->soma / histograma->total, histograma->total);
+}
+
+//Mostra espera e duração dos atendimentos de cada serviço
+void mostrar_latencias_servicos(PainelLatencias* painel) {
+    if (!painel) return;
+    
+    char nome[MAX_NOME];
+    for (int t = 0; t < NUM_TIPOS_SERVICO; t++) {
+        snprintf(nome, sizeof(nome), "%s - espera", tipo_servico_string((TipoServico)t));
+        mostrar_histograma(nome, &painel->por_servico[t].espera);
+        snprintf(nome, sizeof(nome), "%s - atendimento", tipo_servico_string((TipoServico)t));
+        mostrar_histograma(nome, &painel->por_servico[t].servico);
+    }
+}
+
+//Mostra espera e duração dos atendimentos de cada bairro que já teve atendimento
+void mostrar_latencias_bairros(PainelLatencias* painel, ListaCruzada* mapa) {
+    if (!painel || !mapa) return;
+    
+    printf("\n=== TEMPOS DE RESPOSTA POR BAIRRO ===\n");
+    int mostrados = 0;
+    char nome[MAX_NOME + 32];
+    for (int slot = 0; slot < mapa->quantidade && slot < painel->capacidade_bairros; slot++) {
+        LatenciasAtendimento* bairro = &painel->por_bairro[slot];
+        if (bairro->espera.total == 0) continue;
+        
+        NoBairroServico* no = mapa->bairros[slot];
+        snprintf(nome, sizeof(nome), "%s (ID %d) - espera", no->nome_bairro, no->bairro_id);
+        mostrar_histograma(nome, &bairro->espera);
+        snprintf(nome, sizeof(nome), "%s (ID %d) - atendimento", no->nome_bairro, no->bairro_id);
+        mostrar_histograma(nome, &bairro->servico);
+        mostrados++;
+    }
+    
+    if (mostrados == 0) {
+        printf("Nenhum atendimento registrado\n");
+    }
+}
+
+//Grava a linha CSV de um histograma
+void exportar_linha_latencias(FILE* csv, const char* escopo, int chave, const char* metrica, HistogramaLatencia* histograma) {
+    fprintf(csv, "%s,%d,%s,%lld,%.3f,%d,%d,%d,%d\n", escopo, chave, metrica, histograma->total,
+            histograma->total ? (double)histograma->soma / histograma->total : 0.0,
+            percentil_histograma(histograma, 50), percentil_histograma(histograma, 90),
+            percentil_histograma(histograma, 99), histograma->maximo);
+}
+
+//Exporta os percentis de todos os histogramas em CSV (serviço pelo número do tipo, bairro pelo ID)
+//Retorna 1 se gravou o arquivo
+int exportar_latencias(PainelLatencias* painel, ListaCruzada* mapa, const char* arquivo_csv) {
+    if (!painel || !mapa || !arquivo_csv) return 0;
+    
+    FILE* csv = fopen(arquivo_csv, "w");
+    if (!csv) {
+        printf("Não foi possível criar o arquivo %s!\n", arquivo_csv);
+        return 0;
+    }
+    
+    fprintf(csv, "escopo,chave,metrica,atendimentos,media,p50,p90,p99,maximo\n");
+    for (int t = 0; t < NUM_TIPOS_SERVICO; t++) {
+        exportar_linha_latencias(csv, "servico", t + 1, "espera", &painel->por_servico[t].espera);
+        exportar_linha_latencias(csv, "servico", t + 1, "atendimento", &painel->por_servico[t].servico);
+    }
+    for (int slot = 0; slot < mapa->quantidade && slot < painel->capacidade_bairros; slot++) {
+        if (painel->por_bairro[slot].espera.total == 0) continue;
+        
+        exportar_linha_latencias(csv, "bairro", mapa->bairros[slot]->bairro_id, "espera", &painel->por_bairro[slot].espera);
+        exportar_linha_latencias(csv, "bairro", mapa->bairros[slot]->bairro_id, "atendimento", &painel->por_bairro[slot].servico);
+    }
+    
+    fclose(csv);
+    printf("Tempos de resposta exportados para %s\n", arquivo_csv);
+    return 1;
+}
+
+//Libera o painel de latências
+void liberar_painel_latencias(PainelLatencias* painel) {
+    if (!painel) return;
+    
+    free(painel->por_bairro);
+    free(painel);
+}
+
+// ==================== IMPLEMENTAÇÃO - ÁRVORE BST ====================
+
+//Cria uma nova árvore BST
+ArvoreBST* criar_arvore_bst() {
+    ArvoreBST* arvore = (ArvoreBST*)malloc(sizeof(ArvoreBST));
+    if (!arvore) return NULL;
+    
+    arvore->raiz = NULL;
+    arvore->tamanho = 0;
+    
+    return arvore;
+}
+
+//Retorna a ocorrência que contém o nó da BST (o nó é um campo da própria ocorrência)
+Ocorrencia* ocorrencia_do_no_bst(NoArvoreBST* no) {
+    return (Ocorrencia*)((char*)no - offsetof(Ocorrencia, no_bst));
+}
+
+//Prepara o nó embutido na ocorrência para entrar na árvore BST (não aloca nada)
+NoArvoreBST* iniciar_no_bst(Ocorrencia* ocorrencia) {
+    if (!ocorrencia) return NULL;
+    
+    //A BST é a dona das ocorrências: o nó é a própria ocorrência
+    NoArvoreBST* novo = &ocorrencia->no_bst;
+    novo->esquerda = NULL;
+    novo->direita = NULL;
+    
+    return novo;
+}
+
+//Insere uma ocorrência na árvore BST (ordenada por ID)
+int inserir_bst(ArvoreBST* arvore, Ocorrencia* ocorrencia) {
+    if (!arvore || !ocorrencia) return 0;
+    
+    if (arvore->raiz == NULL) {
+        arvore->raiz = iniciar_no_bst(ocorrencia);
+        arvore->tamanho++;
+        return 1;
+    }
+    
+    NoArvoreBST* atual = arvore->raiz;
+    NoArvoreBST* pai = NULL;
+    
+    //Busca a posição para inserção
+    while (atual != NULL) {
+        pai = atual;
+        if (ocorrencia->id < ocorrencia_do_no_bst(atual)->id) {
+            atual = atual->esquerda;
+        } else if (ocorrencia->id > ocorrencia_do_no_bst(atual)->id) {
+            atual = atual->direita;
+        } else {
+            //ID já existe, não insere
+            return 0;
+        }
+    }
+    
+    //Insere o novo nó
+    NoArvoreBST* novo = iniciar_no_bst(ocorrencia);
+    
+    if (ocorrencia->id < ocorrencia_do_no_bst(pai)->id) {
+        pai->esquerda = novo;
+    } else {
+        pai->direita = novo;
+    }
+    
+    arvore->tamanho++;
+    return 1;
+}
+
+//Busca um nó na árvore BST por ID
+NoArvoreBST* buscar_bst(ArvoreBST* arvore, int id) {
+    if (!arvore) return NULL;
+    
+    NoArvoreBST* atual = arvore->raiz;
+    
+    while (atual != NULL) {
+        if (id == ocorrencia_do_no_bst(atual)->id) {
+            return atual;
+        } else if (id < ocorrencia_do_no_bst(atual)->id) {
+            atual = atual->esquerda;
+        } else {
+            atual = atual->direita;
+        }
+    }
+    
+    return NULL;
+}
+
+//Busca uma ocorrência por ID e retorna a ocorrência
+Ocorrencia* buscar_ocorrencia_por_id(ArvoreBST* arvore, int id) {
+    NoArvoreBST* no = buscar_bst(arvore, id);
+    return no ? ocorrencia_do_no_bst(no) : NULL;
+}
+
+//Percorre a árvore em ordem (esquerda, raiz, direita)
+void percorrer_em_ordem_bst(NoArvoreBST* no) {
+    if (no != NULL) {
+        percorrer_em_ordem_bst(no->esquerda);
+        mostrar_ocorrencia(ocorrencia_do_no_bst(no));
+        percorrer_em_ordem_bst(no->direita);
+    }
+}
+
+//Percorre a árvore em pré-ordem (raiz, esquerda, direita)
+void percorrer_pre_ordem_bst(NoArvoreBST* no) {
+    if (no != NULL) {
+        mostrar_ocorrencia(ocorrencia_do_no_bst(no));
+        percorrer_pre_ordem_bst(no->esquerda);
+        percorrer_pre_ordem_bst(no->direita);
+    }
+}
+
+//Percorre a árvore em pós-ordem (esquerda, direita, raiz)
+void percorrer_pos_ordem_bst(NoArvoreBST* no) {
+    if (no != NULL) {
+        percorrer_pos_ordem_bst(no->esquerda);
+        percorrer_pos_ordem_bst(no->direita);
+        mostrar_ocorrencia(ocorrencia_do_no_bst(no));
+    }
+}
+
+//Mostra informações gerais da árvore BST
+void mostrar_arvore_bst(ArvoreBST* arvore) {
+    if (!arvore || !arvore->raiz) {
+        printf("Árvore BST vazia\n");
+        return;
+    }
+    
+    printf("\n=== ÁRVORE BST - OCORRÊNCIAS ===\n");
+    printf("Total de ocorrências: %d\n", arvore->tamanho);
+    printf("Ocorrências ordenadas por ID:\n");
+    percorrer_em_ordem_bst(arvore->raiz);
+}
+
+//Mostra árvore ordenada por ID (em ordem)
+void mostrar_arvore_ordenada_por_id(ArvoreBST* arvore) {
+    if (!arvore || !arvore->raiz) {
+        printf("Nenhuma ocorrência cadastrada na árvore\n");
+        return;
+    }
+    
+    printf("\n=== CONSULTA ORDENADA POR ID ===\n");
+    percorrer_em_ordem_bst(arvore->raiz);
+}
+
+//Copia as ocorrências da árvore para um vetor, em ordem de ID (função auxiliar recursiva)
+void coletar_ocorrencias_bst(NoArvoreBST* no, Ocorrencia** vetor, int* quantidade) {
+    if (no != NULL) {
+        coletar_ocorrencias_bst(no->esquerda, vetor, quantidade);
+        vetor[(*quantidade)++] = ocorrencia_do_no_bst(no);
+        coletar_ocorrencias_bst(no->direita, vetor, quantidade);
+    }
+}
+
+//Compara duas ocorrências pelo tempo de chegada e, no empate, pelo ID (para qsort)
+int comparar_ocorrencias_por_tempo(const void* a, const void* b) {
+    const Ocorrencia* x = *(Ocorrencia* const*)a;
+    const Ocorrencia* y = *(Ocorrencia* const*)b;
+    
+    if (x->tempo_chegada != y->tempo_chegada) return x->tempo_chegada < y->tempo_chegada ? -1 : 1;
+    return (x->id > y->id) - (x->id < y->id);
+}
+
+//Mostra as ocorrências da árvore ordenadas por tempo de chegada
+//A árvore é ordenada por ID, então as ocorrências são copiadas e ordenadas à parte
+void mostrar_arvore_ordenada_por_tempo(ArvoreBST* arvore) {
+    if (!arvore || !arvore->raiz) {
         printf("Nenhuma ocorrência cadastrada na árvore\n");
         return;
     }
     
+    Ocorrencia** vetor = (Ocorrencia**)malloc(arvore->tamanho * sizeof(Ocorrencia*));
+    if (!vetor) return;
+    
+    int quantidade = 0;
+    coletar_ocorrencias_bst(arvore->raiz, vetor, &quantidade);
+    qsort(vetor, quantidade, sizeof(Ocorrencia*), comparar_ocorrencias_por_tempo);
+    
     printf("\n=== CONSULTA ORDENADA POR TEMPO DE CHEGADA ===\n");
-    percorrer_pre_ordem_bst(arvore->raiz);
+    for (int i = 0; i < quantidade; i++) {
+        mostrar_ocorrencia(vetor[i]);
+    }
+    free(vetor);
+}
+
+//Desliga o menor nó de uma subárvore e retorna a nova raiz da subárvore
+NoArvoreBST* remover_menor_bst(NoArvoreBST* no) {
+    if (no->esquerda == NULL) return no->direita;
+    
+    no->esquerda = remover_menor_bst(no->esquerda);
+    return no;
 }
 
 //Remove um nó da árvore BST (função auxiliar recursiva)
 NoArvoreBST* remover_bst(NoArvoreBST* no, int id) {
     if (no == NULL) return no;
     
-    if (id < no->ocorrencia->id) {
+    if (id < ocorrencia_do_no_bst(no)->id) {
         no->esquerda = remover_bst(no->esquerda, id);
-    } else if (id > no->ocorrencia->id) {
+    } else if (id > ocorrencia_do_no_bst(no)->id) {
         no->direita = remover_bst(no->direita, id);
     } else {
         //Nó encontrado para remoção
         if (no->esquerda == NULL) {
             NoArvoreBST* temp = no->direita;
-            free(no->ocorrencia);
-            free(no);
+            liberar_ocorrencia(ocorrencia_do_no_bst(no));
             return temp;
         } else if (no->direita == NULL) {
             NoArvoreBST* temp = no->esquerda;
-            free(no->ocorrencia);
-            free(no);
+            liberar_ocorrencia(ocorrencia_do_no_bst(no));
             return temp;
         }
         
         //Nó com dois filhos: encontra o sucessor em ordem
-        NoArvoreBST* temp = no->direita;
-        while (temp->esquerda != NULL) {
-            temp = temp->esquerda;
+        NoArvoreBST* sucessor = no->direita;
+        while (sucessor->esquerda != NULL) {
+            sucessor = sucessor->esquerda;
         }
         
-        //Copia os dados do sucessor
-        *(no->ocorrencia) = *(temp->ocorrencia);
-        
-        //Remove o sucessor
-        no->direita = remover_bst(no->direita, temp->ocorrencia->id);
+        //O nó é a própria ocorrência, então não dá para trocar o conteúdo: o nó do
+        //sucessor é desligado da subárvore direita e religado no lugar do removido
+        sucessor->direita = remover_menor_bst(no->direita);
+        sucessor->esquerda = no->esquerda;
+        liberar_ocorrencia(ocorrencia_do_no_bst(no));
+        return sucessor;
     }
     
     return no;
@@ -864,16 +2525,11 @@ NoArvoreBST* remover_bst(NoArvoreBST* no, int id) {
 
 //Remove uma ocorrência da árvore BST
 int remover_ocorrencia_bst(ArvoreBST* arvore, int id) {
-    if (!arvore) return 0;
-    
-    NoArvoreBST* resultado = remover_bst(arvore->raiz, id);
-    if (resultado != arvore->raiz || buscar_bst(arvore, id) == NULL) {
-        arvore->raiz = resultado;
-        arvore->tamanho--;
-        return 1;
-    }
+    if (!arvore || buscar_bst(arvore, id) == NULL) return 0;
     
-    return 0;
+    arvore->raiz = remover_bst(arvore->raiz, id);
+    arvore->tamanho--;
+    return 1;
 }
 
 //Libera memória da árvore BST (função auxiliar recursiva)
@@ -881,8 +2537,7 @@ void liberar_arvore_bst(NoArvoreBST* no) {
     if (no != NULL) {
         liberar_arvore_bst(no->esquerda);
         liberar_arvore_bst(no->direita);
-        free(no->ocorrencia);
-        free(no);
+        liberar_ocorrencia(ocorrencia_do_no_bst(no));
     }
 }
 
@@ -907,23 +2562,24 @@ ArvoreAVL* criar_arvore_avl() {
     return arvore;
 }
 
-//Cria um novo nó para a árvore AVL
-NoArvoreAVL* criar_no_avl(Ocorrencia* ocorrencia) {
+//Retorna a ocorrência que contém o nó da AVL (o nó é um campo da própria ocorrência)
+Ocorrencia* ocorrencia_do_no_avl(NoArvoreAVL* no) {
+    return (Ocorrencia*)((char*)no - offsetof(Ocorrencia, no_avl));
+}
+
+//Prepara o nó embutido na ocorrência para entrar na árvore AVL (não aloca nada)
+NoArvoreAVL* iniciar_no_avl(Ocorrencia* ocorrencia) {
     if (!ocorrencia) return NULL;
     
-    NoArvoreAVL* novo = (NoArvoreAVL*)malloc(sizeof(NoArvoreAVL));
-    if (!novo) return NULL;
-    
-    //Cria uma cópia da ocorrência
-    novo->ocorrencia = (Ocorrencia*)malloc(sizeof(Ocorrencia));
-    if (!novo->ocorrencia) {
-        free(novo);
-        return NULL;
-    }
-    
-    *(novo->ocorrencia) = *ocorrencia; //Copia os dados
+    //A AVL apenas indexa a ocorrência (a dona é o índice por ID)
+    NoArvoreAVL* novo = &ocorrencia->no_avl;
     novo->altura = 1;
+    novo->tamanho_subarvore = 1;
     novo->fator_balanceamento = 0;
+    for (int i = 0; i < NUM_TIPOS_SERVICO; i++) {
+        novo->contagem_servico[i] = 0;
+    }
+    novo->contagem_servico[ocorrencia->tipo_servico] = 1;
     novo->esquerda = NULL;
     novo->direita = NULL;
     
@@ -945,6 +2601,28 @@ int max_int(int a, int b) {
     return (a > b) ? a : b;
 }
 
+//Retorna quantas ocorrências do serviço existem na subárvore
+int contagem_servico_avl(NoArvoreAVL* no, TipoServico tipo) {
+    return no ? no->contagem_servico[tipo] : 0;
+}
+
+//Retorna quantos nós existem na subárvore
+int tamanho_subarvore_avl(NoArvoreAVL* no) {
+    return no ? no->tamanho_subarvore : 0;
+}
+
+//Recalcula altura, fator de balanceamento, tamanho e contagens por serviço a partir dos filhos
+void atualizar_no_avl(NoArvoreAVL* no) {
+    no->altura = 1 + max_int(altura_avl(no->esquerda), altura_avl(no->direita));
+    no->fator_balanceamento = fator_balanceamento_avl(no);
+    no->tamanho_subarvore = 1 + tamanho_subarvore_avl(no->esquerda) + tamanho_subarvore_avl(no->direita);
+    for (int i = 0; i < NUM_TIPOS_SERVICO; i++) {
+        no->contagem_servico[i] = contagem_servico_avl(no->esquerda, (TipoServico)i) +
+                                  contagem_servico_avl(no->direita, (TipoServico)i);
+    }
+    no->contagem_servico[ocorrencia_do_no_avl(no)->tipo_servico]++;
+}
+
 //Rotação simples à direita
 NoArvoreAVL* rotacao_direita(NoArvoreAVL* y) {
     NoArvoreAVL* x = y->esquerda;
@@ -954,13 +2632,9 @@ NoArvoreAVL* rotacao_direita(NoArvoreAVL* y) {
     x->direita = y;
     y->esquerda = T2;
     
-    //Atualiza as alturas
-    y->altura = max_int(altura_avl(y->esquerda), altura_avl(y->direita)) + 1;
-    x->altura = max_int(altura_avl(x->esquerda), altura_avl(x->direita)) + 1;
-    
-    //Atualiza fatores de balanceamento
-    y->fator_balanceamento = fator_balanceamento_avl(y);
-    x->fator_balanceamento = fator_balanceamento_avl(x);
+    //Atualiza alturas, fatores de balanceamento e contagens (primeiro o nó que desceu)
+    atualizar_no_avl(y);
+    atualizar_no_avl(x);
     
     return x;
 }
@@ -974,13 +2648,9 @@ NoArvoreAVL* rotacao_esquerda(NoArvoreAVL* x) {
     y->esquerda = x;
     x->direita = T2;
     
-    //Atualiza as alturas
-    x->altura = max_int(altura_avl(x->esquerda), altura_avl(x->direita)) + 1;
-    y->altura = max_int(altura_avl(y->esquerda), altura_avl(y->direita)) + 1;
-    
-    //Atualiza fatores de balanceamento
-    x->fator_balanceamento = fator_balanceamento_avl(x);
-    y->fator_balanceamento = fator_balanceamento_avl(y);
+    //Atualiza alturas, fatores de balanceamento e contagens (primeiro o nó que desceu)
+    atualizar_no_avl(x);
+    atualizar_no_avl(y);
     
     return y;
 }
@@ -989,240 +2659,1263 @@ NoArvoreAVL* rotacao_esquerda(NoArvoreAVL* x) {
 NoArvoreAVL* inserir_avl(NoArvoreAVL* no, Ocorrencia* ocorrencia) {
     //1. Inserção normal da BST
     if (no == NULL) {
-        return criar_no_avl(ocorrencia);
+        return iniciar_no_avl(ocorrencia);
     }
     
     //Compara primeiro por gravidade (maior gravidade = maior prioridade)
     //Em caso de empate, compara por ID
-    if (ocorrencia->gravidade > no->ocorrencia->gravidade || 
-        (ocorrencia->gravidade == no->ocorrencia->gravidade && ocorrencia->id < no->ocorrencia->id)) {
+    int comparacao = comparar_prioridade_avl(ocorrencia->gravidade, ocorrencia->id, ocorrencia_do_no_avl(no));
+    if (comparacao < 0) {
         no->esquerda = inserir_avl(no->esquerda, ocorrencia);
-    } else if (ocorrencia->gravidade < no->ocorrencia->gravidade || 
-               (ocorrencia->gravidade == no->ocorrencia->gravidade && ocorrencia->id > no->ocorrencia->id)) {
+    } else if (comparacao > 0) {
         no->direita = inserir_avl(no->direita, ocorrencia);
     } else {
         //Ocorrência duplicada, não insere
         return no;
     }
     
-    //2. Atualiza altura do nó atual
-    no->altura = 1 + max_int(altura_avl(no->esquerda), altura_avl(no->direita));
-    
-    //3. Calcula o fator de balanceamento
-    int balanceamento = fator_balanceamento_avl(no);
-    no->fator_balanceamento = balanceamento;
+    //2. Atualiza altura, contagens e fator de balanceamento do nó atual
+    atualizar_no_avl(no);
+    int balanceamento = no->fator_balanceamento;
     
-    //4. Se o nó ficou desbalanceado, executa as rotações necessárias
+    //3. Se o nó ficou desbalanceado, executa as rotações necessárias
     
     //Caso Esquerda-Esquerda
-    if (balanceamento > 1 && (ocorrencia->gravidade > no->esquerda->ocorrencia->gravidade || 
-        (ocorrencia->gravidade == no->esquerda->ocorrencia->gravidade && ocorrencia->id < no->esquerda->ocorrencia->id))) {
+    if (balanceamento > 1 &&
+        comparar_prioridade_avl(ocorrencia->gravidade, ocorrencia->id, ocorrencia_do_no_avl(no->esquerda)) < 0) {
         return rotacao_direita(no);
     }
     
-    //Caso Direita-Direita
-    if (balanceamento < -1 && (ocorrencia->gravidade < no->direita->ocorrencia->gravidade || 
-        (ocorrencia->gravidade == no->direita->ocorrencia->gravidade && ocorrencia->id > no->direita->ocorrencia->id))) {
-        return rotacao_esquerda(no);
+    //Caso Direita-Direita
+    if (balanceamento < -1 &&
+        comparar_prioridade_avl(ocorrencia->gravidade, ocorrencia->id, ocorrencia_do_no_avl(no->direita)) > 0) {
+        return rotacao_esquerda(no);
+    }
+    
+    //Caso Esquerda-Direita
+    if (balanceamento > 1 &&
+        comparar_prioridade_avl(ocorrencia->gravidade, ocorrencia->id, ocorrencia_do_no_avl(no->esquerda)) > 0) {
+        no->esquerda = rotacao_esquerda(no->esquerda);
+        return rotacao_direita(no);
+    }
+    
+    //Caso Direita-Esquerda
+    if (balanceamento < -1 &&
+        comparar_prioridade_avl(ocorrencia->gravidade, ocorrencia->id, ocorrencia_do_no_avl(no->direita)) < 0) {
+        no->direita = rotacao_direita(no->direita);
+        return rotacao_esquerda(no);
+    }
+    
+    //Retorna o nó (inalterado)
+    return no;
+}
+
+//Insere uma ocorrência na árvore AVL
+int inserir_avl_arvore(ArvoreAVL* arvore, Ocorrencia* ocorrencia) {
+    if (!arvore || !ocorrencia) return 0;
+    
+    int antes = tamanho_subarvore_avl(arvore->raiz);
+    arvore->raiz = inserir_avl(arvore->raiz, ocorrencia);
+    
+    //Chave repetida não cria nó: o tamanho da raiz só cresce se a inserção aconteceu
+    if (tamanho_subarvore_avl(arvore->raiz) == antes) return 0;
+    
+    arvore->tamanho++;
+    return 1;
+}
+
+//Busca um nó na árvore AVL por gravidade
+NoArvoreAVL* buscar_avl(NoArvoreAVL* no, int gravidade) {
+    if (no == NULL || ocorrencia_do_no_avl(no)->gravidade == gravidade) {
+        return no;
+    }
+    
+    if (gravidade > ocorrencia_do_no_avl(no)->gravidade) {
+        return buscar_avl(no->esquerda, gravidade);
+    }
+    
+    return buscar_avl(no->direita, gravidade);
+}
+
+//Busca uma ocorrência por gravidade
+Ocorrencia* buscar_por_gravidade(ArvoreAVL* arvore, int gravidade) {
+    if (!arvore) return NULL;
+    
+    NoArvoreAVL* no = buscar_avl(arvore->raiz, gravidade);
+    return no ? ocorrencia_do_no_avl(no) : NULL;
+}
+
+//Busca uma ocorrência exata pela chave (gravidade, id) da AVL
+Ocorrencia* buscar_ocorrencia_avl(ArvoreAVL* arvore, int gravidade, int id) {
+    if (!arvore) return NULL;
+    
+    NoArvoreAVL* no = arvore->raiz;
+    while (no) {
+        int comparacao = comparar_prioridade_avl(gravidade, id, ocorrencia_do_no_avl(no));
+        if (comparacao < 0) {
+            no = no->esquerda;
+        } else if (comparacao > 0) {
+            no = no->direita;
+        } else {
+            return ocorrencia_do_no_avl(no);
+        }
+    }
+    
+    return NULL;
+}
+
+//Retorna a ocorrência mais prioritária de um serviço, sem removê-la
+//Desce pela esquerda enquanto a subárvore tiver ocorrências do serviço: O(log n)
+Ocorrencia* maior_prioridade_servico(ArvoreAVL* arvore, TipoServico tipo) {
+    if (!arvore) return NULL;
+    
+    NoArvoreAVL* no = arvore->raiz;
+    while (no && no->contagem_servico[tipo] > 0) {
+        if (contagem_servico_avl(no->esquerda, tipo) > 0) {
+            no = no->esquerda;
+        } else if (ocorrencia_do_no_avl(no)->tipo_servico == tipo) {
+            return ocorrencia_do_no_avl(no);
+        } else {
+            no = no->direita;
+        }
+    }
+    
+    return NULL;
+}
+
+//Remove da árvore e retorna a ocorrência mais prioritária de um serviço
+Ocorrencia* extrair_maior_prioridade(ArvoreAVL* arvore, TipoServico tipo) {
+    Ocorrencia* ocorrencia = maior_prioridade_servico(arvore, tipo);
+    if (ocorrencia) {
+        remover_ocorrencia_avl(arvore, ocorrencia->gravidade, ocorrencia->id);
+    }
+    return ocorrencia;
+}
+
+//Compara a chave (gravidade, id) com uma ocorrência na ordem da AVL
+//Retorna negativo se a chave vem antes (mais prioritária), 0 se é a mesma e positivo se vem depois
+int comparar_prioridade_avl(int gravidade, int id, Ocorrencia* ocorrencia) {
+    if (gravidade != ocorrencia->gravidade) return gravidade > ocorrencia->gravidade ? -1 : 1;
+    return (id > ocorrencia->id) - (id < ocorrencia->id);
+}
+
+//Retorna a posição (1 = mais urgente) de uma ocorrência na ordem de prioridade, ou 0 se não estiver na árvore
+//Soma os tamanhos das subárvores deixadas à esquerda durante a descida: O(log n)
+int posicao_prioridade_avl(ArvoreAVL* arvore, int gravidade, int id) {
+    if (!arvore) return 0;
+    
+    int anteriores = 0;
+    NoArvoreAVL* no = arvore->raiz;
+    while (no) {
+        int comparacao = comparar_prioridade_avl(gravidade, id, ocorrencia_do_no_avl(no));
+        if (comparacao < 0) {
+            no = no->esquerda;
+        } else if (comparacao > 0) {
+            anteriores += tamanho_subarvore_avl(no->esquerda) + 1;
+            no = no->direita;
+        } else {
+            return anteriores + tamanho_subarvore_avl(no->esquerda) + 1;
+        }
+    }
+    
+    return 0;
+}
+
+//Conta as ocorrências que vêm antes da chave (gravidade, id) na ordem de prioridade em O(log n)
+//Diferente de posicao_prioridade_avl, a chave não precisa estar na árvore
+int contar_anteriores_avl(ArvoreAVL* arvore, int gravidade, int id) {
+    if (!arvore) return 0;
+    
+    int anteriores = 0;
+    NoArvoreAVL* no = arvore->raiz;
+    while (no) {
+        int comparacao = comparar_prioridade_avl(gravidade, id, ocorrencia_do_no_avl(no));
+        if (comparacao <= 0) {
+            no = no->esquerda;
+        } else {
+            anteriores += tamanho_subarvore_avl(no->esquerda) + 1;
+            no = no->direita;
+        }
+    }
+    
+    return anteriores;
+}
+
+//Retorna a k-ésima ocorrência mais urgente (k a partir de 1) em O(log n)
+Ocorrencia* k_esima_prioridade_avl(ArvoreAVL* arvore, int k) {
+    if (!arvore) return NULL;
+    
+    NoArvoreAVL* no = arvore->raiz;
+    while (no) {
+        int esquerda = tamanho_subarvore_avl(no->esquerda);
+        if (k <= esquerda) {
+            no = no->esquerda;
+        } else if (k == esquerda + 1) {
+            return ocorrencia_do_no_avl(no);
+        } else {
+            k -= esquerda + 1;
+            no = no->direita;
+        }
+    }
+    
+    return NULL;
+}
+
+//Conta as ocorrências com gravidade maior ou igual à informada em O(log n)
+//Elas formam o início da ordem de prioridade
+int contar_gravidade_minima_avl(ArvoreAVL* arvore, int gravidade) {
+    if (!arvore) return 0;
+    
+    int total = 0;
+    NoArvoreAVL* no = arvore->raiz;
+    while (no) {
+        if (ocorrencia_do_no_avl(no)->gravidade >= gravidade) {
+            total += tamanho_subarvore_avl(no->esquerda) + 1;
+            no = no->direita;
+        } else {
+            no = no->esquerda;
+        }
+    }
+    
+    return total;
+}
+
+//Conta as ocorrências com gravidade entre gravidade_min e gravidade_max (inclusive)
+int contar_gravidade_faixa_avl(ArvoreAVL* arvore, int gravidade_min, int gravidade_max) {
+    if (gravidade_min > gravidade_max) return 0;
+    
+    return contar_gravidade_minima_avl(arvore, gravidade_min) -
+           contar_gravidade_minima_avl(arvore, gravidade_max + 1);
+}
+
+//Percorre a árvore AVL por prioridade (em ordem decrescente de gravidade)
+void percorrer_por_prioridade(NoArvoreAVL* no) {
+    if (no != NULL) {
+        percorrer_por_prioridade(no->esquerda);
+        Ocorrencia* ocorrencia = ocorrencia_do_no_avl(no);
+        printf("PRIORIDADE %d | ID: %d | Bairro: %d | %s | Tempo: %d | FB: %d\n",
+               ocorrencia->gravidade, ocorrencia->id, ocorrencia->bairro_id,
+               tipo_servico_string(ocorrencia->tipo_servico),
+               ocorrencia->tempo_chegada, no->fator_balanceamento);
+        percorrer_por_prioridade(no->direita);
+    }
+}
+
+//Mostra informações gerais da árvore AVL
+void mostrar_arvore_avl(ArvoreAVL* arvore) {
+    if (!arvore || !arvore->raiz) {
+        printf("Árvore AVL vazia\n");
+        return;
+    }
+    
+    printf("\n=== ÁRVORE AVL - PRIORIDADES ===\n");
+    printf("Total de ocorrências: %d\n", arvore->tamanho);
+    printf("Árvore balanceada automaticamente\n");
+    printf("Ocorrências ordenadas por prioridade (gravidade):\n");
+    percorrer_por_prioridade(arvore->raiz);
+}
+
+//Mostra ocorrências ordenadas por prioridade
+void mostrar_ocorrencias_por_prioridade(ArvoreAVL* arvore) {
+    if (!arvore || !arvore->raiz) {
+        printf("Nenhuma ocorrência cadastrada na árvore de prioridades\n");
+        return;
+    }
+    
+    printf("\n=== CONSULTA POR PRIORIDADE ===\n");
+    printf("(Maior gravidade = Maior prioridade)\n");
+    percorrer_por_prioridade(arvore->raiz);
+}
+
+//Atualiza o nó e, se ele ficou desbalanceado depois de uma remoção, executa as rotações necessárias
+//Retorna a nova raiz da subárvore
+NoArvoreAVL* balancear_no_avl(NoArvoreAVL* no) {
+    //1. Atualiza altura, contagens e fator de balanceamento do nó atual
+    atualizar_no_avl(no);
+    int balanceamento = no->fator_balanceamento;
+    
+    //2. Se o nó ficou desbalanceado, executa as rotações necessárias
+    
+    //Caso Esquerda-Esquerda
+    if (balanceamento > 1 && fator_balanceamento_avl(no->esquerda) >= 0) {
+        return rotacao_direita(no);
+    }
+    
+    //Caso Esquerda-Direita
+    if (balanceamento > 1 && fator_balanceamento_avl(no->esquerda) < 0) {
+        no->esquerda = rotacao_esquerda(no->esquerda);
+        return rotacao_direita(no);
+    }
+    
+    //Caso Direita-Direita
+    if (balanceamento < -1 && fator_balanceamento_avl(no->direita) <= 0) {
+        return rotacao_esquerda(no);
+    }
+    
+    //Caso Direita-Esquerda
+    if (balanceamento < -1 && fator_balanceamento_avl(no->direita) > 0) {
+        no->direita = rotacao_direita(no->direita);
+        return rotacao_esquerda(no);
+    }
+    
+    return no;
+}
+
+//Desliga o menor nó de uma subárvore e retorna a nova raiz, já rebalanceada
+NoArvoreAVL* remover_menor_avl(NoArvoreAVL* no) {
+    if (no->esquerda == NULL) return no->direita;
+    
+    no->esquerda = remover_menor_avl(no->esquerda);
+    return balancear_no_avl(no);
+}
+
+//Remove um nó da árvore AVL (função auxiliar recursiva)
+NoArvoreAVL* remover_avl(NoArvoreAVL* no, int gravidade, int id) {
+    //1. Remoção normal da BST
+    if (no == NULL) return no;
+    
+    int comparacao = comparar_prioridade_avl(gravidade, id, ocorrencia_do_no_avl(no));
+    if (comparacao < 0) {
+        no->esquerda = remover_avl(no->esquerda, gravidade, id);
+    } else if (comparacao > 0) {
+        no->direita = remover_avl(no->direita, gravidade, id);
+    } else {
+        //Nó encontrado para remoção
+        if ((no->esquerda == NULL) || (no->direita == NULL)) {
+            //Com no máximo um filho, a subárvore do filho (já balanceada) ocupa o lugar do nó
+            return no->esquerda ? no->esquerda : no->direita;
+        }
+        
+        //Nó com dois filhos: encontra o sucessor em ordem
+        NoArvoreAVL* sucessor = no->direita;
+        while (sucessor->esquerda != NULL) {
+            sucessor = sucessor->esquerda;
+        }
+        
+        //O nó é a própria ocorrência, então não dá para trocar o conteúdo: o nó do
+        //sucessor é desligado da subárvore direita e ocupa o lugar do removido
+        sucessor->direita = remover_menor_avl(no->direita);
+        sucessor->esquerda = no->esquerda;
+        no = sucessor;
+    }
+    
+    //2. Atualiza o nó atual e rebalanceia se necessário
+    return balancear_no_avl(no);
+}
+
+//Remove uma ocorrência da árvore AVL
+int remover_ocorrencia_avl(ArvoreAVL* arvore, int gravidade, int id) {
+    if (!arvore) return 0;
+    
+    int antes = tamanho_subarvore_avl(arvore->raiz);
+    arvore->raiz = remover_avl(arvore->raiz, gravidade, id);
+    
+    //Chave ausente deixa a árvore intacta e não pode mexer no contador
+    if (tamanho_subarvore_avl(arvore->raiz) == antes) return 0;
+    
+    arvore->tamanho--;
+    return 1;
+}
+
+//Muda a gravidade de uma ocorrência da árvore em O(log n): sai com a chave antiga e volta com a nova
+//Retorna 1 se reposicionou e 0 se a ocorrência não estava na árvore
+int reclassificar_avl(ArvoreAVL* arvore, Ocorrencia* ocorrencia, int nova_gravidade) {
+    if (!arvore || !ocorrencia) return 0;
+    if (!remover_ocorrencia_avl(arvore, ocorrencia->gravidade, ocorrencia->id)) return 0;
+    
+    ocorrencia->gravidade = nova_gravidade;
+    return inserir_avl_arvore(arvore, ocorrencia);
+}
+
+//Libera a árvore AVL
+//Os nós estão dentro das ocorrências, que pertencem ao índice por ID: só a estrutura da árvore é liberada
+void liberar_avl_completa(ArvoreAVL* arvore) {
+    if (!arvore) return;
+    
+    free(arvore);
+}
+
+// ==================== IMPLEMENTAÇÃO - FILA DE PRIORIDADE EM BALDES ====================
+
+//Cria uma fila de baldes vazia
+FilaBaldes* criar_fila_baldes() {
+    FilaBaldes* fila = (FilaBaldes*)calloc(1, sizeof(FilaBaldes));
+    return fila;
+}
+
+//Retorna o balde de uma ocorrência (a gravidade já está em 1..NIVEIS_GRAVIDADE desde criar_ocorrencia,
+//então baldes e AVL ordenam pela mesma gravidade)
+BaldeGravidade* balde_da_ocorrencia(FilaBaldes* fila, Ocorrencia* ocorrencia) {
+    return &fila->baldes[ocorrencia->tipo_servico][ocorrencia->gravidade - 1];
+}
+
+//Verifica se a ocorrência está no balde: na lista em O(1) ou, senão, na árvore em O(log n)
+int esta_no_balde(BaldeGravidade* balde, Ocorrencia* ocorrencia) {
+    if (ocorrencia->ant || balde->primeira == ocorrencia) return 1;
+    return balde->fora_de_ordem.raiz &&
+           buscar_ocorrencia_avl(&balde->fora_de_ordem, ocorrencia->gravidade, ocorrencia->id) == ocorrencia;
+}
+
+//Retorna a ocorrência de menor ID do balde: o início da lista ou a menor da árvore
+Ocorrencia* primeira_do_balde(BaldeGravidade* balde) {
+    if (!balde->fora_de_ordem.raiz) return balde->primeira;
+    
+    Ocorrencia* reclassificada = k_esima_prioridade_avl(&balde->fora_de_ordem, 1);
+    if (!balde->primeira || reclassificada->id < balde->primeira->id) return reclassificada;
+    return balde->primeira;
+}
+
+//Insere uma ocorrência no seu balde
+//Chegadas têm o maior ID do balde e entram no fim da lista em O(1); uma reclassificada
+//mais antiga que a última da lista entra na árvore do balde em O(log n)
+int inserir_fila_baldes(FilaBaldes* fila, Ocorrencia* ocorrencia) {
+    if (!fila || !ocorrencia) return 0;
+    
+    BaldeGravidade* balde = balde_da_ocorrencia(fila, ocorrencia);
+    if (balde->ultima && balde->ultima->id > ocorrencia->id) {
+        if (!inserir_avl_arvore(&balde->fora_de_ordem, ocorrencia)) return 0;
+    } else {
+        ocorrencia->ant = balde->ultima;
+        ocorrencia->prox = NULL;
+        if (balde->ultima) {
+            balde->ultima->prox = ocorrencia;
+        } else {
+            balde->primeira = ocorrencia;
+        }
+        balde->ultima = ocorrencia;
+    }
+    balde->tamanho++;
+    fila->tamanho++;
+    
+    return 1;
+}
+
+//Remove uma ocorrência de qualquer posição do seu balde: O(1) na lista, O(log n) na árvore
+int remover_fila_baldes(FilaBaldes* fila, Ocorrencia* ocorrencia) {
+    if (!fila || !ocorrencia) return 0;
+    
+    BaldeGravidade* balde = balde_da_ocorrencia(fila, ocorrencia);
+    if (!ocorrencia->ant && balde->primeira != ocorrencia) {
+        //Fora da lista: ou está na árvore do balde ou não está na fila
+        if (!remover_ocorrencia_avl(&balde->fora_de_ordem, ocorrencia->gravidade, ocorrencia->id)) return 0;
+        balde->tamanho--;
+        fila->tamanho--;
+        return 1;
+    }
+    
+    if (ocorrencia->ant) {
+        ocorrencia->ant->prox = ocorrencia->prox;
+    } else {
+        balde->primeira = ocorrencia->prox;
+    }
+    if (ocorrencia->prox) {
+        ocorrencia->prox->ant = ocorrencia->ant;
+    } else {
+        balde->ultima = ocorrencia->ant;
+    }
+    ocorrencia->prox = NULL;
+    ocorrencia->ant = NULL;
+    balde->tamanho--;
+    fila->tamanho--;
+    
+    return 1;
+}
+
+//Muda a gravidade de uma ocorrência da fila em O(log n): sai do balde antigo e entra no novo na ordem de ID
+//Retorna 1 se reposicionou e 0 se a ocorrência não estava na fila
+int reclassificar_fila_baldes(FilaBaldes* fila, Ocorrencia* ocorrencia, int nova_gravidade) {
+    if (!fila || !ocorrencia) return 0;
+    if (!remover_fila_baldes(fila, ocorrencia)) return 0;
+    
+    ocorrencia->gravidade = nova_gravidade;
+    return inserir_fila_baldes(fila, ocorrencia);
+}
+
+//Retorna a ocorrência mais prioritária de um serviço: a mais antiga do balde não vazio de maior gravidade
+Ocorrencia* maior_prioridade_baldes(FilaBaldes* fila, TipoServico tipo) {
+    if (!fila) return NULL;
+    
+    for (int nivel = NIVEIS_GRAVIDADE - 1; nivel >= 0; nivel--) {
+        if (fila->baldes[tipo][nivel].tamanho > 0) return primeira_do_balde(&fila->baldes[tipo][nivel]);
+    }
+    return NULL;
+}
+
+//Remove e retorna a ocorrência mais prioritária de um serviço
+Ocorrencia* extrair_maior_prioridade_baldes(FilaBaldes* fila, TipoServico tipo) {
+    Ocorrencia* ocorrencia = maior_prioridade_baldes(fila, tipo);
+    if (ocorrencia) {
+        remover_fila_baldes(fila, ocorrencia);
+    }
+    return ocorrencia;
+}
+
+//Retorna a primeira ocorrência (menor ID) de uma gravidade, entre todos os serviços
+Ocorrencia* buscar_por_gravidade_baldes(FilaBaldes* fila, int gravidade) {
+    if (!fila || gravidade < 1 || gravidade > NIVEIS_GRAVIDADE) return NULL;
+    
+    Ocorrencia* melhor = NULL;
+    for (int t = 0; t < NUM_TIPOS_SERVICO; t++) {
+        Ocorrencia* primeira = primeira_do_balde(&fila->baldes[t][gravidade - 1]);
+        if (primeira && (!melhor || primeira->id < melhor->id)) melhor = primeira;
+    }
+    return melhor;
+}
+
+//Conta as ocorrências com gravidade entre gravidade_min e gravidade_max somando os tamanhos dos baldes
+int contar_gravidade_faixa_baldes(FilaBaldes* fila, int gravidade_min, int gravidade_max) {
+    if (!fila) return 0;
+    if (gravidade_min < 1) gravidade_min = 1;
+    if (gravidade_max > NIVEIS_GRAVIDADE) gravidade_max = NIVEIS_GRAVIDADE;
+    
+    int total = 0;
+    for (int nivel = gravidade_min - 1; nivel < gravidade_max; nivel++) {
+        for (int t = 0; t < NUM_TIPOS_SERVICO; t++) {
+            total += fila->baldes[t][nivel].tamanho;
+        }
+    }
+    return total;
+}
+
+//Retorna a posição (1 = mais urgente) de uma ocorrência na ordem de prioridade, ou 0 se não estiver na fila
+//Os níveis acima contam pelo tamanho; no próprio nível, percorre as listas até o ID dela
+//e conta as reclassificadas anteriores pelas árvores
+int posicao_prioridade_baldes(FilaBaldes* fila, Ocorrencia* ocorrencia) {
+    if (!fila || !ocorrencia) return 0;
+    
+    BaldeGravidade* balde = balde_da_ocorrencia(fila, ocorrencia);
+    if (!esta_no_balde(balde, ocorrencia)) return 0;
+    
+    int nivel = (int)(balde - fila->baldes[ocorrencia->tipo_servico]);
+    int posicao = contar_gravidade_faixa_baldes(fila, nivel + 2, NIVEIS_GRAVIDADE) + 1;
+    for (int t = 0; t < NUM_TIPOS_SERVICO; t++) {
+        for (Ocorrencia* atual = fila->baldes[t][nivel].primeira; atual && atual->id < ocorrencia->id; atual = atual->prox) {
+            posicao++;
+        }
+        posicao += contar_anteriores_avl(&fila->baldes[t][nivel].fora_de_ordem, ocorrencia->gravidade, ocorrencia->id);
+    }
+    return posicao;
+}
+
+//Posiciona um cursor no início de cada balde de um nível
+void iniciar_nivel_baldes(FilaBaldes* fila, int nivel, CursorBalde* cursores) {
+    for (int t = 0; t < NUM_TIPOS_SERVICO; t++) {
+        cursores[t].lista = fila->baldes[t][nivel].primeira;
+        cursores[t].arvore = &fila->baldes[t][nivel].fora_de_ordem;
+        cursores[t].posicao = 1;
+        cursores[t].reclassificada = k_esima_prioridade_avl(cursores[t].arvore, 1);
+    }
+}
+
+//Retorna a ocorrência em que o cursor está (a de menor ID entre a lista e a árvore), ou NULL no fim
+Ocorrencia* atual_do_cursor(CursorBalde* cursor) {
+    if (!cursor->reclassificada) return cursor->lista;
+    if (!cursor->lista || cursor->reclassificada->id < cursor->lista->id) return cursor->reclassificada;
+    return cursor->lista;
+}
+
+//Retorna a próxima ocorrência de um nível em ordem de ID, intercalando os baldes dos serviços
+Ocorrencia* proxima_do_nivel_baldes(CursorBalde* cursores) {
+    int menor = -1;
+    Ocorrencia* ocorrencia = NULL;
+    for (int t = 0; t < NUM_TIPOS_SERVICO; t++) {
+        Ocorrencia* atual = atual_do_cursor(&cursores[t]);
+        if (atual && (!ocorrencia || atual->id < ocorrencia->id)) {
+            menor = t;
+            ocorrencia = atual;
+        }
+    }
+    if (menor < 0) return NULL;
+    
+    CursorBalde* cursor = &cursores[menor];
+    if (ocorrencia == cursor->lista) {
+        cursor->lista = ocorrencia->prox;
+    } else {
+        cursor->posicao++;
+        cursor->reclassificada = k_esima_prioridade_avl(cursor->arvore, cursor->posicao);
+    }
+    return ocorrencia;
+}
+
+//Retorna a k-ésima ocorrência mais urgente (k a partir de 1)
+//Pula níveis inteiros pelo tamanho e intercala os baldes do nível por ID
+Ocorrencia* k_esima_prioridade_baldes(FilaBaldes* fila, int k) {
+    if (!fila || k < 1 || k > fila->tamanho) return NULL;
+    
+    for (int nivel = NIVEIS_GRAVIDADE - 1; nivel >= 0; nivel--) {
+        int no_nivel = contar_gravidade_faixa_baldes(fila, nivel + 1, nivel + 1);
+        if (k > no_nivel) {
+            k -= no_nivel;
+            continue;
+        }
+        
+        CursorBalde cursores[NUM_TIPOS_SERVICO];
+        Ocorrencia* ocorrencia;
+        iniciar_nivel_baldes(fila, nivel, cursores);
+        do {
+            ocorrencia = proxima_do_nivel_baldes(cursores);
+        } while (--k > 0);
+        return ocorrencia;
+    }
+    return NULL;
+}
+
+//Mostra as ocorrências em ordem de prioridade (gravidade decrescente, depois ID)
+void mostrar_fila_baldes(FilaBaldes* fila) {
+    if (!fila || fila->tamanho == 0) {
+        printf("Nenhuma ocorrência cadastrada na fila de prioridades\n");
+        return;
+    }
+    
+    printf("\n=== CONSULTA POR PRIORIDADE ===\n");
+    printf("(Maior gravidade = Maior prioridade)\n");
+    for (int nivel = NIVEIS_GRAVIDADE - 1; nivel >= 0; nivel--) {
+        CursorBalde cursores[NUM_TIPOS_SERVICO];
+        Ocorrencia* ocorrencia;
+        iniciar_nivel_baldes(fila, nivel, cursores);
+        while ((ocorrencia = proxima_do_nivel_baldes(cursores)) != NULL) {
+            printf("PRIORIDADE %d | ID: %d | Bairro: %d | %s | Tempo: %d\n",
+                   ocorrencia->gravidade, ocorrencia->id, ocorrencia->bairro_id,
+                   tipo_servico_string(ocorrencia->tipo_servico), ocorrencia->tempo_chegada);
+        }
+    }
+}
+
+//Mostra a ocupação de cada balde
+void mostrar_estrutura_baldes(FilaBaldes* fila) {
+    if (!fila || fila->tamanho == 0) {
+        printf("Fila de baldes vazia\n");
+        return;
+    }
+    
+    printf("\n=== FILA DE BALDES - PRIORIDADES ===\n");
+    printf("Total de ocorrências: %d\n", fila->tamanho);
+    for (int nivel = NIVEIS_GRAVIDADE - 1; nivel >= 0; nivel--) {
+        printf("Gravidade %d:", nivel + 1);
+        for (int t = 0; t < NUM_TIPOS_SERVICO; t++) {
+            printf(" [%s: %d]", tipo_servico_string((TipoServico)t), fila->baldes[t][nivel].tamanho);
+        }
+        printf("\n");
+    }
+}
+
+//Libera a fila de baldes (as ocorrências pertencem ao índice por ID)
+void liberar_fila_baldes(FilaBaldes* fila) {
+    free(fila);
+}
+
+// ==================== IMPLEMENTAÇÃO - ÍNDICE DE PRIORIDADES ====================
+//Encaminha para a árvore AVL ou, com -DPRIORIDADES_BALDES, para a fila de baldes
+
+#ifdef PRIORIDADES_BALDES
+
+IndicePrioridades* criar_indice_prioridades() {
+    return criar_fila_baldes();
+}
+
+int inserir_prioridade(IndicePrioridades* indice, Ocorrencia* ocorrencia) {
+    return inserir_fila_baldes(indice, ocorrencia);
+}
+
+int remover_prioridade(IndicePrioridades* indice, Ocorrencia* ocorrencia) {
+    return remover_fila_baldes(indice, ocorrencia);
+}
+
+int reclassificar_prioridade(IndicePrioridades* indice, Ocorrencia* ocorrencia, int nova_gravidade) {
+    return reclassificar_fila_baldes(indice, ocorrencia, nova_gravidade);
+}
+
+Ocorrencia* extrair_prioridade(IndicePrioridades* indice, TipoServico tipo) {
+    return extrair_maior_prioridade_baldes(indice, tipo);
+}
+
+Ocorrencia* buscar_prioridade_por_gravidade(IndicePrioridades* indice, int gravidade) {
+    return buscar_por_gravidade_baldes(indice, gravidade);
+}
+
+int posicao_prioridade(IndicePrioridades* indice, Ocorrencia* ocorrencia) {
+    return posicao_prioridade_baldes(indice, ocorrencia);
+}
+
+Ocorrencia* k_esima_prioridade(IndicePrioridades* indice, int k) {
+    return k_esima_prioridade_baldes(indice, k);
+}
+
+int contar_prioridades_gravidade(IndicePrioridades* indice, int gravidade_min, int gravidade_max) {
+    return contar_gravidade_faixa_baldes(indice, gravidade_min, gravidade_max);
+}
+
+void mostrar_prioridades(IndicePrioridades* indice) {
+    mostrar_fila_baldes(indice);
+}
+
+void mostrar_estrutura_prioridades(IndicePrioridades* indice) {
+    mostrar_estrutura_baldes(indice);
+}
+
+const char* nome_indice_prioridades() {
+    return "Fila de baldes";
+}
+
+const char* complexidade_indice_prioridades() {
+    return "O(1) por balde de serviço e gravidade";
+}
+
+void liberar_indice_prioridades(IndicePrioridades* indice) {
+    liberar_fila_baldes(indice);
+}
+
+#else
+
+IndicePrioridades* criar_indice_prioridades() {
+    return criar_arvore_avl();
+}
+
+int inserir_prioridade(IndicePrioridades* indice, Ocorrencia* ocorrencia) {
+    return inserir_avl_arvore(indice, ocorrencia);
+}
+
+int remover_prioridade(IndicePrioridades* indice, Ocorrencia* ocorrencia) {
+    return ocorrencia ? remover_ocorrencia_avl(indice, ocorrencia->gravidade, ocorrencia->id) : 0;
+}
+
+int reclassificar_prioridade(IndicePrioridades* indice, Ocorrencia* ocorrencia, int nova_gravidade) {
+    return reclassificar_avl(indice, ocorrencia, nova_gravidade);
+}
+
+Ocorrencia* extrair_prioridade(IndicePrioridades* indice, TipoServico tipo) {
+    return extrair_maior_prioridade(indice, tipo);
+}
+
+Ocorrencia* buscar_prioridade_por_gravidade(IndicePrioridades* indice, int gravidade) {
+    return buscar_por_gravidade(indice, gravidade);
+}
+
+int posicao_prioridade(IndicePrioridades* indice, Ocorrencia* ocorrencia) {
+    return ocorrencia ? posicao_prioridade_avl(indice, ocorrencia->gravidade, ocorrencia->id) : 0;
+}
+
+Ocorrencia* k_esima_prioridade(IndicePrioridades* indice, int k) {
+    return k_esima_prioridade_avl(indice, k);
+}
+
+int contar_prioridades_gravidade(IndicePrioridades* indice, int gravidade_min, int gravidade_max) {
+    return contar_gravidade_faixa_avl(indice, gravidade_min, gravidade_max);
+}
+
+void mostrar_prioridades(IndicePrioridades* indice) {
+    mostrar_ocorrencias_por_prioridade(indice);
+}
+
+void mostrar_estrutura_prioridades(IndicePrioridades* indice) {
+    mostrar_arvore_avl(indice);
+}
+
+const char* nome_indice_prioridades() {
+    return "AVL";
+}
+
+const char* complexidade_indice_prioridades() {
+    return "O(log n) garantido, com balanceamento automático";
+}
+
+void liberar_indice_prioridades(IndicePrioridades* indice) {
+    liberar_avl_completa(indice);
+}
+
+#endif
+
+// ==================== IMPLEMENTAÇÃO - ÁRVORE B+ ====================
+
+//Cria uma árvore B+ vazia (a raiz começa como uma folha sem chaves)
+ArvoreBMais* criar_arvore_bmais(CriterioBMais criterio) {
+    ArvoreBMais* arvore = (ArvoreBMais*)malloc(sizeof(ArvoreBMais));
+    if (!arvore) return NULL;
+    
+    arvore->raiz = criar_no_bmais(1);
+    if (!arvore->raiz) {
+        free(arvore);
+        return NULL;
+    }
+    arvore->criterio = criterio;
+    arvore->tamanho = 0;
+    arvore->altura = 1;
+    
+    return arvore;
+}
+
+//Cria um nó vazio da árvore B+
+NoArvoreBMais* criar_no_bmais(int folha) {
+    NoArvoreBMais* no = (NoArvoreBMais*)pool_alocar(&pool_nos_bmais);
+    if (!no) return NULL;
+    
+    no->folha = folha;
+    no->quantidade = 0;
+    no->prox = NULL;
+    
+    return no;
+}
+
+//Calcula a chave de uma ocorrência conforme o critério da árvore
+uint64_t chave_bmais(ArvoreBMais* arvore, Ocorrencia* ocorrencia) {
+    if (arvore->criterio == BMAIS_POR_TEMPO) {
+        return ((uint64_t)(uint32_t)ocorrencia->tempo_chegada << 32) | (uint32_t)ocorrencia->id;
+    }
+    return (uint32_t)ocorrencia->id;
+}
+
+//Escolhe o filho de um nó interno que cobre a chave
+//O separador i é a menor chave do filho i + 1
+int posicao_filho_bmais(NoArvoreBMais* no, uint64_t chave) {
+    int i = 0;
+    while (i < no->quantidade && chave >= no->chaves[i]) {
+        i++;
+    }
+    return i;
+}
+
+//Insere na subárvore (função auxiliar recursiva)
+//Se o nó dividir, retorna o novo irmão da direita e a chave que o separa
+NoArvoreBMais* inserir_no_bmais(NoArvoreBMais* no, uint64_t chave, Ocorrencia* ocorrencia, uint64_t* separadora, int* inserida) {
+    if (no->folha) {
+        int pos = 0;
+        while (pos < no->quantidade && no->chaves[pos] < chave) {
+            pos++;
+        }
+        if (pos < no->quantidade && no->chaves[pos] == chave) {
+            *inserida = 0; //Chave já existe
+            return NULL;
+        }
+        
+        memmove(&no->chaves[pos + 1], &no->chaves[pos], (no->quantidade - pos) * sizeof(uint64_t));
+        memmove(&no->ponteiros.ocorrencias[pos + 1], &no->ponteiros.ocorrencias[pos],
+                (no->quantidade - pos) * sizeof(Ocorrencia*));
+        no->chaves[pos] = chave;
+        no->ponteiros.ocorrencias[pos] = ocorrencia;
+        no->quantidade++;
+        *inserida = 1;
+        
+        if (no->quantidade <= ORDEM_ARVORE_BMAIS) return NULL;
+        
+        //Folha transbordou: a metade de cima vai para uma folha nova, encadeada logo depois
+        NoArvoreBMais* novo = criar_no_bmais(1);
+        if (!novo) return NULL;
+        int meio = no->quantidade / 2;
+        novo->quantidade = no->quantidade - meio;
+        memcpy(novo->chaves, &no->chaves[meio], novo->quantidade * sizeof(uint64_t));
+        memcpy(novo->ponteiros.ocorrencias, &no->ponteiros.ocorrencias[meio], novo->quantidade * sizeof(Ocorrencia*));
+        no->quantidade = meio;
+        novo->prox = no->prox;
+        no->prox = novo;
+        
+        *separadora = novo->chaves[0];
+        return novo;
+    }
+    
+    int i = posicao_filho_bmais(no, chave);
+    uint64_t chave_filho;
+    NoArvoreBMais* irmao = inserir_no_bmais(no->ponteiros.filhos[i], chave, ocorrencia, &chave_filho, inserida);
+    if (!irmao) return NULL;
+    
+    memmove(&no->chaves[i + 1], &no->chaves[i], (no->quantidade - i) * sizeof(uint64_t));
+    memmove(&no->ponteiros.filhos[i + 2], &no->ponteiros.filhos[i + 1],
+            (no->quantidade - i) * sizeof(NoArvoreBMais*));
+    no->chaves[i] = chave_filho;
+    no->ponteiros.filhos[i + 1] = irmao;
+    no->quantidade++;
+    
+    if (no->quantidade <= ORDEM_ARVORE_BMAIS) return NULL;
+    
+    //Nó interno transbordou: a chave do meio sobe e não fica em nenhuma das metades
+    NoArvoreBMais* novo = criar_no_bmais(0);
+    if (!novo) return NULL;
+    int meio = no->quantidade / 2;
+    novo->quantidade = no->quantidade - meio - 1;
+    memcpy(novo->chaves, &no->chaves[meio + 1], novo->quantidade * sizeof(uint64_t));
+    memcpy(novo->ponteiros.filhos, &no->ponteiros.filhos[meio + 1], (novo->quantidade + 1) * sizeof(NoArvoreBMais*));
+    no->quantidade = meio;
+    
+    *separadora = no->chaves[meio];
+    return novo;
+}
+
+//Insere uma ocorrência na árvore B+ (a árvore não é dona da ocorrência)
+int inserir_bmais(ArvoreBMais* arvore, Ocorrencia* ocorrencia) {
+    if (!arvore || !ocorrencia) return 0;
+    
+    uint64_t separadora;
+    int inserida = 0;
+    NoArvoreBMais* irmao = inserir_no_bmais(arvore->raiz, chave_bmais(arvore, ocorrencia),
+                                            ocorrencia, &separadora, &inserida);
+    if (irmao) {
+        //A raiz dividiu: a árvore cresce um nível para cima
+        NoArvoreBMais* raiz = criar_no_bmais(0);
+        if (raiz) {
+            raiz->quantidade = 1;
+            raiz->chaves[0] = separadora;
+            raiz->ponteiros.filhos[0] = arvore->raiz;
+            raiz->ponteiros.filhos[1] = irmao;
+            arvore->raiz = raiz;
+            arvore->altura++;
+        }
+    }
+    
+    if (inserida) arvore->tamanho++;
+    return inserida;
+}
+
+//Corrige o filho i que ficou com menos da metade das chaves,
+//pegando uma chave emprestada de um irmão ou fundindo com ele
+void rebalancear_filho_bmais(NoArvoreBMais* pai, int i) {
+    int minimo = ORDEM_ARVORE_BMAIS / 2;
+    NoArvoreBMais* filho = pai->ponteiros.filhos[i];
+    NoArvoreBMais* esquerdo = i > 0 ? pai->ponteiros.filhos[i - 1] : NULL;
+    NoArvoreBMais* direito = i < pai->quantidade ? pai->ponteiros.filhos[i + 1] : NULL;
+    
+    if (esquerdo && esquerdo->quantidade > minimo) {
+        //Empréstimo do irmão esquerdo: a última chave dele passa para o início do filho
+        memmove(&filho->chaves[1], &filho->chaves[0], filho->quantidade * sizeof(uint64_t));
+        if (filho->folha) {
+            memmove(&filho->ponteiros.ocorrencias[1], &filho->ponteiros.ocorrencias[0],
+                    filho->quantidade * sizeof(Ocorrencia*));
+            filho->chaves[0] = esquerdo->chaves[esquerdo->quantidade - 1];
+            filho->ponteiros.ocorrencias[0] = esquerdo->ponteiros.ocorrencias[esquerdo->quantidade - 1];
+            pai->chaves[i - 1] = filho->chaves[0];
+        } else {
+            memmove(&filho->ponteiros.filhos[1], &filho->ponteiros.filhos[0],
+                    (filho->quantidade + 1) * sizeof(NoArvoreBMais*));
+            filho->chaves[0] = pai->chaves[i - 1];
+            filho->ponteiros.filhos[0] = esquerdo->ponteiros.filhos[esquerdo->quantidade];
+            pai->chaves[i - 1] = esquerdo->chaves[esquerdo->quantidade - 1];
+        }
+        esquerdo->quantidade--;
+        filho->quantidade++;
+        return;
+    }
+    
+    if (direito && direito->quantidade > minimo) {
+        //Empréstimo do irmão direito: a primeira chave dele passa para o fim do filho
+        if (filho->folha) {
+            filho->chaves[filho->quantidade] = direito->chaves[0];
+            filho->ponteiros.ocorrencias[filho->quantidade] = direito->ponteiros.ocorrencias[0];
+            memmove(&direito->ponteiros.ocorrencias[0], &direito->ponteiros.ocorrencias[1],
+                    (direito->quantidade - 1) * sizeof(Ocorrencia*));
+            memmove(&direito->chaves[0], &direito->chaves[1], (direito->quantidade - 1) * sizeof(uint64_t));
+            pai->chaves[i] = direito->chaves[0];
+        } else {
+            filho->chaves[filho->quantidade] = pai->chaves[i];
+            filho->ponteiros.filhos[filho->quantidade + 1] = direito->ponteiros.filhos[0];
+            pai->chaves[i] = direito->chaves[0];
+            memmove(&direito->ponteiros.filhos[0], &direito->ponteiros.filhos[1],
+                    direito->quantidade * sizeof(NoArvoreBMais*));
+            memmove(&direito->chaves[0], &direito->chaves[1], (direito->quantidade - 1) * sizeof(uint64_t));
+        }
+        direito->quantidade--;
+        filho->quantidade++;
+        return;
     }
     
-    //Caso Esquerda-Direita
-    if (balanceamento > 1 && (ocorrencia->gravidade < no->esquerda->ocorrencia->gravidade || 
-        (ocorrencia->gravidade == no->esquerda->ocorrencia->gravidade && ocorrencia->id > no->esquerda->ocorrencia->id))) {
-        no->esquerda = rotacao_esquerda(no->esquerda);
-        return rotacao_direita(no);
+    //Nenhum irmão pode emprestar: funde o par (k, k + 1) no nó da esquerda
+    int k = esquerdo ? i - 1 : i;
+    NoArvoreBMais* destino = pai->ponteiros.filhos[k];
+    NoArvoreBMais* origem = pai->ponteiros.filhos[k + 1];
+    
+    if (destino->folha) {
+        memcpy(&destino->chaves[destino->quantidade], origem->chaves, origem->quantidade * sizeof(uint64_t));
+        memcpy(&destino->ponteiros.ocorrencias[destino->quantidade], origem->ponteiros.ocorrencias,
+               origem->quantidade * sizeof(Ocorrencia*));
+        destino->quantidade += origem->quantidade;
+        destino->prox = origem->prox;
+    } else {
+        //O separador desce e fica entre as chaves das duas metades
+        destino->chaves[destino->quantidade] = pai->chaves[k];
+        memcpy(&destino->chaves[destino->quantidade + 1], origem->chaves, origem->quantidade * sizeof(uint64_t));
+        memcpy(&destino->ponteiros.filhos[destino->quantidade + 1], origem->ponteiros.filhos,
+               (origem->quantidade + 1) * sizeof(NoArvoreBMais*));
+        destino->quantidade += origem->quantidade + 1;
     }
+    pool_liberar(&pool_nos_bmais, origem);
     
-    //Caso Direita-Esquerda
-    if (balanceamento < -1 && (ocorrencia->gravidade > no->direita->ocorrencia->gravidade || 
-        (ocorrencia->gravidade == no->direita->ocorrencia->gravidade && ocorrencia->id < no->direita->ocorrencia->id))) {
-        no->direita = rotacao_direita(no->direita);
-        return rotacao_esquerda(no);
+    memmove(&pai->chaves[k], &pai->chaves[k + 1], (pai->quantidade - k - 1) * sizeof(uint64_t));
+    memmove(&pai->ponteiros.filhos[k + 1], &pai->ponteiros.filhos[k + 2],
+            (pai->quantidade - k - 1) * sizeof(NoArvoreBMais*));
+    pai->quantidade--;
+}
+
+//Remove uma chave da subárvore (função auxiliar recursiva)
+//Os separadores dos nós internos podem continuar com chaves já removidas; eles só orientam a descida
+int remover_no_bmais(NoArvoreBMais* no, uint64_t chave) {
+    if (no->folha) {
+        int pos = 0;
+        while (pos < no->quantidade && no->chaves[pos] < chave) {
+            pos++;
+        }
+        if (pos == no->quantidade || no->chaves[pos] != chave) return 0;
+        
+        memmove(&no->chaves[pos], &no->chaves[pos + 1], (no->quantidade - pos - 1) * sizeof(uint64_t));
+        memmove(&no->ponteiros.ocorrencias[pos], &no->ponteiros.ocorrencias[pos + 1],
+                (no->quantidade - pos - 1) * sizeof(Ocorrencia*));
+        no->quantidade--;
+        return 1;
     }
     
-    //Retorna o nó (inalterado)
-    return no;
+    int i = posicao_filho_bmais(no, chave);
+    if (!remover_no_bmais(no->ponteiros.filhos[i], chave)) return 0;
+    
+    if (no->ponteiros.filhos[i]->quantidade < ORDEM_ARVORE_BMAIS / 2) {
+        rebalancear_filho_bmais(no, i);
+    }
+    return 1;
 }
 
-//Insere uma ocorrência na árvore AVL
-int inserir_avl_arvore(ArvoreAVL* arvore, Ocorrencia* ocorrencia) {
+//Remove uma ocorrência da árvore B+
+int remover_bmais(ArvoreBMais* arvore, Ocorrencia* ocorrencia) {
     if (!arvore || !ocorrencia) return 0;
     
-    arvore->raiz = inserir_avl(arvore->raiz, ocorrencia);
+    if (!remover_no_bmais(arvore->raiz, chave_bmais(arvore, ocorrencia))) return 0;
+    arvore->tamanho--;
     
-    //Verifica se a inserção foi bem-sucedida
-    if (arvore->raiz) {
-        arvore->tamanho++;
-        return 1;
+    //Raiz interna sem chaves: o único filho vira a raiz
+    if (!arvore->raiz->folha && arvore->raiz->quantidade == 0) {
+        NoArvoreBMais* antiga = arvore->raiz;
+        arvore->raiz = antiga->ponteiros.filhos[0];
+        pool_liberar(&pool_nos_bmais, antiga);
+        arvore->altura--;
     }
     
-    return 0;
+    return 1;
 }
 
-//Busca um nó na árvore AVL por gravidade
-NoArvoreAVL* buscar_avl(NoArvoreAVL* no, int gravidade) {
-    if (no == NULL || no->ocorrencia->gravidade == gravidade) {
-        return no;
+//Posiciona o iterador na primeira chave da faixa [de, ate]
+//Por tempo, a faixa cobre todas as ocorrências que chegaram entre os dois instantes
+void iniciar_faixa_bmais(ArvoreBMais* arvore, int de, int ate, IteradorBMais* iterador) {
+    iterador->folha = NULL;
+    iterador->posicao = 0;
+    iterador->fim = 0;
+    if (!arvore || ate < de || ate < 0) return;
+    if (de < 0) de = 0;
+    
+    uint64_t inicio = (uint32_t)de;
+    iterador->fim = (uint32_t)ate;
+    if (arvore->criterio == BMAIS_POR_TEMPO) {
+        inicio <<= 32;
+        iterador->fim = (iterador->fim << 32) | 0xFFFFFFFFu;
     }
     
-    if (gravidade > no->ocorrencia->gravidade) {
-        return buscar_avl(no->esquerda, gravidade);
+    NoArvoreBMais* no = arvore->raiz;
+    while (!no->folha) {
+        no = no->ponteiros.filhos[posicao_filho_bmais(no, inicio)];
     }
     
-    return buscar_avl(no->direita, gravidade);
+    int pos = 0;
+    while (pos < no->quantidade && no->chaves[pos] < inicio) {
+        pos++;
+    }
+    iterador->folha = no;
+    iterador->posicao = pos;
 }
 
-//Busca uma ocorrência por gravidade
-Ocorrencia* buscar_por_gravidade(ArvoreAVL* arvore, int gravidade) {
-    if (!arvore) return NULL;
+//Retorna a próxima ocorrência da faixa, seguindo o encadeamento das folhas
+//Retorna NULL quando a faixa termina
+Ocorrencia* proxima_da_faixa_bmais(IteradorBMais* iterador) {
+    while (iterador->folha && iterador->posicao >= iterador->folha->quantidade) {
+        iterador->folha = iterador->folha->prox;
+        iterador->posicao = 0;
+    }
+    if (!iterador->folha || iterador->folha->chaves[iterador->posicao] > iterador->fim) {
+        iterador->folha = NULL;
+        return NULL;
+    }
     
-    NoArvoreAVL* no = buscar_avl(arvore->raiz, gravidade);
-    return no ? no->ocorrencia : NULL;
+    return iterador->folha->ponteiros.ocorrencias[iterador->posicao++];
 }
 
-//Percorre a árvore AVL por prioridade (em ordem decrescente de gravidade)
-void percorrer_por_prioridade(NoArvoreAVL* no) {
-    if (no != NULL) {
-        percorrer_por_prioridade(no->esquerda);
-        printf("PRIORIDADE %d | ID: %d | Bairro: %d | %s | Tempo: %d | FB: %d\n",
-               no->ocorrencia->gravidade, no->ocorrencia->id, no->ocorrencia->bairro_id,
-               tipo_servico_string(no->ocorrencia->tipo_servico),
-               no->ocorrencia->tempo_chegada, no->fator_balanceamento);
-        percorrer_por_prioridade(no->direita);
+//Mostra as ocorrências de uma faixa e retorna quantas foram encontradas
+int mostrar_faixa_bmais(ArvoreBMais* arvore, int de, int ate) {
+    IteradorBMais iterador;
+    Ocorrencia* ocorrencia;
+    int encontradas = 0;
+    
+    iniciar_faixa_bmais(arvore, de, ate, &iterador);
+    while ((ocorrencia = proxima_da_faixa_bmais(&iterador)) != NULL) {
+        mostrar_ocorrencia(ocorrencia);
+        encontradas++;
+    }
+    
+    if (encontradas == 0) {
+        printf("Nenhuma ocorrência na faixa %d..%d\n", de, ate);
+    } else {
+        printf("Total na faixa %d..%d: %d\n", de, ate, encontradas);
     }
+    return encontradas;
 }
 
-//Mostra informações gerais da árvore AVL
-void mostrar_arvore_avl(ArvoreAVL* arvore) {
-    if (!arvore || !arvore->raiz) {
-        printf("Árvore AVL vazia\n");
-        return;
-    }
+//Libera os nós da árvore B+ (função auxiliar recursiva)
+void liberar_no_bmais(NoArvoreBMais* no) {
+    if (!no) return;
     
-    printf("\n=== ÁRVORE AVL - PRIORIDADES ===\n");
-    printf("Total de ocorrências: %d\n", arvore->tamanho);
-    printf("Árvore balanceada automaticamente\n");
-    printf("Ocorrências ordenadas por prioridade (gravidade):\n");
-    percorrer_por_prioridade(arvore->raiz);
+    if (!no->folha) {
+        for (int i = 0; i <= no->quantidade; i++) {
+            liberar_no_bmais(no->ponteiros.filhos[i]);
+        }
+    }
+    pool_liberar(&pool_nos_bmais, no);
 }
 
-//Mostra ocorrências ordenadas por prioridade
-void mostrar_ocorrencias_por_prioridade(ArvoreAVL* arvore) {
-    if (!arvore || !arvore->raiz) {
-        printf("Nenhuma ocorrência cadastrada na árvore de prioridades\n");
-        return;
-    }
+//Libera toda a árvore B+ (as ocorrências pertencem ao índice por ID)
+void liberar_arvore_bmais(ArvoreBMais* arvore) {
+    if (!arvore) return;
     
-    printf("\n=== CONSULTA POR PRIORIDADE ===\n");
-    printf("(Maior gravidade = Maior prioridade)\n");
-    percorrer_por_prioridade(arvore->raiz);
+    liberar_no_bmais(arvore->raiz);
+    free(arvore);
 }
 
-//Remove um nó da árvore AVL (função auxiliar recursiva)
-NoArvoreAVL* remover_avl(NoArvoreAVL* no, int gravidade, int id) {
-    //1. Remoção normal da BST
-    if (no == NULL) return no;
+// ==================== IMPLEMENTAÇÃO - LOG ====================
+//Sem a thread escritora (modo interativo) cada mensagem é escrita na hora, para não se
+//misturar com os menus; no modo lote ela vai para o anel e a escritora faz o stdio
+
+int nivel_log = NIVEL_LOG_DEPURACAO;
+AnelLog anel_log; //Zerado: começa sem thread escritora
+
+//Muda o nível do log em tempo de execução (NIVEL_LOG_SILENCIOSO desliga tudo)
+void definir_nivel_log(int nivel) {
+    if (nivel < NIVEL_LOG_SILENCIOSO) nivel = NIVEL_LOG_SILENCIOSO;
+    if (nivel > NIVEL_LOG_DEPURACAO) nivel = NIVEL_LOG_DEPURACAO;
+    nivel_log = nivel;
+}
+
+//Converte o nome de um nível (SILENCIOSO, ERRO, AVISO, INFO, DEPURACAO) no seu valor
+int ler_nivel_log_texto(const char* texto, int* nivel) {
+    if (!texto || !nivel) return 0;
     
-    if (gravidade > no->ocorrencia->gravidade || 
-        (gravidade == no->ocorrencia->gravidade && id < no->ocorrencia->id)) {
-        no->esquerda = remover_avl(no->esquerda, gravidade, id);
-    } else if (gravidade < no->ocorrencia->gravidade || 
-               (gravidade == no->ocorrencia->gravidade && id > no->ocorrencia->id)) {
-        no->direita = remover_avl(no->direita, gravidade, id);
-    } else {
-        //Nó encontrado para remoção
-        if ((no->esquerda == NULL) || (no->direita == NULL)) {
-            NoArvoreAVL* temp = no->esquerda ? no->esquerda : no->direita;
-            
-            if (temp == NULL) {
-                temp = no;
-                no = NULL;
-            } else {
-                *(no->ocorrencia) = *(temp->ocorrencia);
-                no->esquerda = temp->esquerda;
-                no->direita = temp->direita;
-                no->altura = temp->altura;
-            }
-            
-            free(temp->ocorrencia);
-            free(temp);
-        } else {
-            //Nó com dois filhos: encontra o sucessor em ordem
-            NoArvoreAVL* temp = no->direita;
-            while (temp->esquerda != NULL) {
-                temp = temp->esquerda;
-            }
-            
-            //Copia os dados do sucessor
-            *(no->ocorrencia) = *(temp->ocorrencia);
-            
-            //Remove o sucessor
-            no->direita = remover_avl(no->direita, temp->ocorrencia->gravidade, temp->ocorrencia->id);
+    for (int n = NIVEL_LOG_SILENCIOSO; n <= NIVEL_LOG_DEPURACAO; n++) {
+        if (strcmp(texto, nivel_log_string(n)) == 0) {
+            *nivel = n;
+            return 1;
         }
     }
-    
-    if (no == NULL) return no;
-    
-    //2. Atualiza altura do nó atual
-    no->altura = 1 + max_int(altura_avl(no->esquerda), altura_avl(no->direita));
-    
-    //3. Calcula o fator de balanceamento
-    int balanceamento = fator_balanceamento_avl(no);
-    no->fator_balanceamento = balanceamento;
-    
-    //4. Se o nó ficou desbalanceado, executa as rotações necessárias
-    
-    //Caso Esquerda-Esquerda
-    if (balanceamento > 1 && fator_balanceamento_avl(no->esquerda) >= 0) {
-        return rotacao_direita(no);
+    return 0;
+}
+
+//Retorna o nome de um nível do log
+const char* nivel_log_string(int nivel) {
+    switch (nivel) {
+        case NIVEL_LOG_SILENCIOSO: return "SILENCIOSO";
+        case NIVEL_LOG_ERRO: return "ERRO";
+        case NIVEL_LOG_AVISO: return "AVISO";
+        case NIVEL_LOG_INFO: return "INFO";
+        case NIVEL_LOG_DEPURACAO: return "DEPURACAO";
+        default: return "DESCONHECIDO";
     }
-    
-    //Caso Esquerda-Direita
-    if (balanceamento > 1 && fator_balanceamento_avl(no->esquerda) < 0) {
-        no->esquerda = rotacao_esquerda(no->esquerda);
-        return rotacao_direita(no);
+}
+
+//Formata uma mensagem do log em até TAMANHO_MENSAGEM_LOG bytes, nos dois modos do log
+//Uma mensagem cortada mantém a quebra de linha final, para a seguinte não emendar nela
+void formatar_mensagem_log(char* destino, const char* formato, va_list argumentos) {
+    int tamanho = vsnprintf(destino, TAMANHO_MENSAGEM_LOG, formato, argumentos);
+    size_t tamanho_formato = strlen(formato);
+    
+    if (tamanho >= TAMANHO_MENSAGEM_LOG && tamanho_formato > 0 && formato[tamanho_formato - 1] == '\n') {
+        destino[TAMANHO_MENSAGEM_LOG - 2] = '\n';
+    }
+}
+
+//Registra uma mensagem já aprovada pelo nível (use as macros LOG_*, que fazem esse teste)
+//Com a escritora rodando, só formata a mensagem no anel; espera apenas se o anel estiver cheio
+//Sem ela, escreve na hora, com o mesmo corte de tamanho do anel
+void registrar_log(int nivel, const char* formato, ...) {
+    va_list argumentos;
+    (void)nivel;
+    
+    if (!anel_log.assincrono) {
+        char texto[TAMANHO_MENSAGEM_LOG];
+        va_start(argumentos, formato);
+        formatar_mensagem_log(texto, formato, argumentos);
+        va_end(argumentos);
+        fputs(texto, stdout);
+        return;
     }
     
-    //Caso Direita-Direita
-    if (balanceamento < -1 && fator_balanceamento_avl(no->direita) <= 0) {
-        return rotacao_esquerda(no);
+    unsigned long cabeca = anel_log.cabeca;
+    while (cabeca - __atomic_load_n(&anel_log.cauda, __ATOMIC_ACQUIRE) >= CAPACIDADE_LOG) {
+        sched_yield();
     }
     
-    //Caso Direita-Esquerda
-    if (balanceamento < -1 && fator_balanceamento_avl(no->direita) > 0) {
-        no->direita = rotacao_direita(no->direita);
-        return rotacao_esquerda(no);
+    va_start(argumentos, formato);
+    formatar_mensagem_log(anel_log.mensagens[cabeca & (CAPACIDADE_LOG - 1)].texto, formato, argumentos);
+    va_end(argumentos);
+    
+    //A mensagem fica visível para a escritora só depois de pronta
+    __atomic_store_n(&anel_log.cabeca, cabeca + 1, __ATOMIC_RELEASE);
+}
+
+//Thread escritora: esvazia o anel na saída padrão até receber o pedido de parada
+void* escrever_log(void* argumento) {
+    (void)argumento;
+    struct timespec espera = { 0, ESPERA_ESCRITORA_LOG_NS };
+    unsigned long cauda = anel_log.cauda;
+    
+    for (;;) {
+        //O pedido de parada é lido antes da cabeça: o que foi gravado antes dele ainda sai
+        int encerrar = __atomic_load_n(&anel_log.encerrar, __ATOMIC_ACQUIRE);
+        unsigned long cabeca = __atomic_load_n(&anel_log.cabeca, __ATOMIC_ACQUIRE);
+        
+        if (cauda == cabeca) {
+            fflush(stdout);
+            if (encerrar) break;
+            nanosleep(&espera, NULL);
+            continue;
+        }
+        
+        while (cauda != cabeca) {
+            fputs(anel_log.mensagens[cauda & (CAPACIDADE_LOG - 1)].texto, stdout);
+            cauda++;
+        }
+        __atomic_store_n(&anel_log.cauda, cauda, __ATOMIC_RELEASE);
     }
     
-    return no;
+    return NULL;
 }
 
-//Remove uma ocorrência da árvore AVL
-int remover_ocorrencia_avl(ArvoreAVL* arvore, int gravidade, int id) {
-    if (!arvore) return 0;
+//Liga a thread escritora; retorna 0 (e o log continua síncrono) se ela não puder ser criada
+int iniciar_log_assincrono() {
+    if (anel_log.assincrono) return 1;
+    
+    anel_log.mensagens = (MensagemLog*)malloc(CAPACIDADE_LOG * sizeof(MensagemLog));
+    if (!anel_log.mensagens) return 0;
+    
+    anel_log.cabeca = 0;
+    anel_log.cauda = 0;
+    anel_log.encerrar = 0;
+    if (pthread_create(&anel_log.escritora, NULL, escrever_log, NULL) != 0) {
+        free(anel_log.mensagens);
+        anel_log.mensagens = NULL;
+        return 0;
+    }
     
-    NoArvoreAVL* resultado = remover_avl(arvore->raiz, gravidade, id);
-    arvore->raiz = resultado;
-    arvore->tamanho--;
+    anel_log.assincrono = 1;
     return 1;
 }
 
-//Libera memória da árvore AVL (função auxiliar recursiva)
-void liberar_arvore_avl(NoArvoreAVL* no) {
-    if (no != NULL) {
-        liberar_arvore_avl(no->esquerda);
-        liberar_arvore_avl(no->direita);
-        free(no->ocorrencia);
-        free(no);
+//Espera a escritora esvaziar o anel, antes de escrever na saída padrão por fora do log
+void sincronizar_log() {
+    if (!anel_log.assincrono) return;
+    
+    while (__atomic_load_n(&anel_log.cauda, __ATOMIC_ACQUIRE) != anel_log.cabeca) {
+        sched_yield();
     }
 }
 
-//Libera toda a árvore AVL
-void liberar_avl_completa(ArvoreAVL* arvore) {
-    if (!arvore) return;
+//Escreve o que falta, para a thread escritora e volta ao log síncrono
+void encerrar_log() {
+    if (!anel_log.assincrono) return;
     
-    liberar_arvore_avl(arvore->raiz);
-    free(arvore);
+    __atomic_store_n(&anel_log.encerrar, 1, __ATOMIC_RELEASE);
+    pthread_join(anel_log.escritora, NULL);
+    
+    free(anel_log.mensagens);
+    anel_log.mensagens = NULL;
+    anel_log.assincrono = 0;
 }
 
 // ==================== IMPLEMENTAÇÃO - SISTEMA PRINCIPAL ====================
@@ -1234,7 +3927,7 @@ SistemaEmergencia* inicializar_sistema() {
     
     sistema->bairros = criar_tabela_bairros();
     sistema->cidadaos = criar_tabela_cidadaos();
-    sistema->unidades = NULL;
+    sistema->unidades = criar_registro_unidades();
     sistema->historico_ambulancia = criar_pilha_historico();
     sistema->historico_bombeiro = criar_pilha_historico();
     sistema->historico_policia = criar_pilha_historico();
@@ -1242,10 +3935,20 @@ SistemaEmergencia* inicializar_sistema() {
     sistema->fila_ambulancia = criar_fila();
     sistema->fila_bombeiro = criar_fila();
     sistema->fila_policia = criar_fila();
-    sistema->arvore_ocorrencias = criar_arvore_bst(); 
-    sistema->arvore_prioridades = criar_arvore_avl();
+    sistema->indice_ocorrencias = criar_indice_ocorrencias();
+    sistema->prioridades = criar_indice_prioridades();
+    sistema->faixas_por_id = criar_arvore_bmais(BMAIS_POR_ID);
+    sistema->faixas_por_tempo = criar_arvore_bmais(BMAIS_POR_TEMPO);
+    sistema->arquivo = criar_arquivo_ocorrencias();
+    sistema->latencias = criar_painel_latencias();
+    for (int i = 0; i < NUM_TIPOS_SERVICO; i++) {
+        sistema->canceladas[i] = 0;
+    }
     sistema->tempo_atual = 0;
     sistema->proximo_id_ocorrencia = 1;
+    sistema->modo_despacho = DESPACHO_FIFO;
+    sistema->calendario = criar_calendario_eventos();
+    sistemas_ativos++;
     
     return sistema;
 }
@@ -1257,9 +3960,9 @@ void cadastrar_bairro_sistema(SistemaEmergencia* sistema, int id, const char* no
     if (inserir_bairro(sistema->bairros, id, nome)) {
         //Também adiciona na lista cruzada
         inserir_bairro_servico(sistema->mapa_cidade, id, nome);
-        printf("Bairro cadastrado: ID %d - %s\n", id, nome);
+        LOG_INFO("Bairro cadastrado: ID %d - %s\n", id, nome);
     } else {
-        printf("Erro ao cadastrar bairro! (Pode já existir)\n");
+        LOG_ERRO("Erro ao cadastrar bairro! (Pode já existir)\n");
     }
 }
 
@@ -1270,14 +3973,14 @@ void cadastrar_cidadao_sistema(SistemaEmergencia* sistema, const char* cpf, cons
     
     //Verifica se o bairro existe
     if (!buscar_bairro(sistema->bairros, bairro_id)) {
-        printf("Erro: Bairro ID %d não encontrado!\n", bairro_id);
+        LOG_ERRO("Erro: Bairro ID %d não encontrado!\n", bairro_id);
         return;
     }
     
     if (inserir_cidadao(sistema->cidadaos, cpf, nome, email, endereco, bairro_id)) {
-        printf("Cidadão cadastrado: %s - CPF: %s\n", nome, cpf);
+        LOG_INFO("Cidadão cadastrado: %s - CPF: %s\n", nome, cpf);
     } else {
-        printf("Erro ao cadastrar cidadão! (CPF pode já existir)\n");
+        LOG_ERRO("Erro ao cadastrar cidadão! (CPF inválido ou já existente)\n");
     }
 }
 
@@ -1285,147 +3988,487 @@ void cadastrar_cidadao_sistema(SistemaEmergencia* sistema, const char* cpf, cons
 void cadastrar_unidade_sistema(SistemaEmergencia* sistema, int id, TipoServico tipo, const char* identificacao) {
     if (!sistema) return;
     
-    if (inserir_unidade(&sistema->unidades, id, tipo, identificacao)) {
-        printf("Unidade cadastrada: %s - %s\n", identificacao, tipo_servico_string(tipo));
+    if (inserir_unidade(sistema->unidades, id, tipo, identificacao)) {
+        LOG_INFO("Unidade cadastrada: %s - %s\n", identificacao, tipo_servico_string(tipo));
+    } else {
+        LOG_ERRO("Erro ao cadastrar unidade!\n");
+    }
+}
+
+//Verifica se a gravidade está entre 1 e NIVEIS_GRAVIDADE
+int gravidade_valida(int gravidade) {
+    return gravidade >= 1 && gravidade <= NIVEIS_GRAVIDADE;
+}
+
+//Desfaz o registro de uma ocorrência que falhou no meio de receber_ocorrencia
+//etapas conta as estruturas que já a receberam, na ordem: índice por ID, fila,
+//prioridades, B+ por ID e B+ por tempo. Sem o índice, a ocorrência volta direto ao pool
+void desfazer_recebimento(SistemaEmergencia* sistema, Ocorrencia* ocorrencia, int etapas) {
+    if (etapas >= 5) remover_bmais(sistema->faixas_por_tempo, ocorrencia);
+    if (etapas >= 4) remover_bmais(sistema->faixas_por_id, ocorrencia);
+    if (etapas >= 3) remover_prioridade(sistema->prioridades, ocorrencia);
+    if (etapas >= 2) descartar_da_fila(fila_do_servico(sistema, ocorrencia->tipo_servico), ocorrencia);
+    
+    if (etapas >= 1) {
+        //O índice é o dono: ele libera a ocorrência, e o handle deixado na fila deixa de valer
+        remover_indice_ocorrencia(sistema->indice_ocorrencias, ocorrencia->id);
     } else {
-        printf("Erro ao cadastrar unidade!\n");
+        liberar_ocorrencia(ocorrencia);
     }
 }
 
 //Recebe uma nova ocorrência no sistema 
-void receber_ocorrencia(SistemaEmergencia* sistema, int bairro_id, TipoServico tipo, int gravidade) {
-    if (!sistema) return;
+//Retorna 1 se registrou e 0 se recusou (bairro ou gravidade inválidos, ou falta de memória)
+int receber_ocorrencia(SistemaEmergencia* sistema, int bairro_id, TipoServico tipo, int gravidade) {
+    if (!sistema) return 0;
     
     //Verifica se o bairro existe
     if (!buscar_bairro(sistema->bairros, bairro_id)) {
-        printf("Erro: Bairro ID %d não encontrado!\n", bairro_id);
-        return;
+        LOG_ERRO("Erro: Bairro ID %d não encontrado!\n", bairro_id);
+        return 0;
+    }
+    
+    if (!gravidade_valida(gravidade)) {
+        LOG_ERRO("Erro: Gravidade %d fora da faixa 1-%d!\n", gravidade, NIVEIS_GRAVIDADE);
+        return 0;
+    }
+    
+    Ocorrencia* nova = criar_ocorrencia(sistema->proximo_id_ocorrencia, 
+                                       bairro_id, tipo, gravidade, 
+                                       sistema->tempo_atual);
+    if (!nova) {
+        LOG_ERRO("Erro: Sem memoria para registrar a ocorrencia!\n");
+        return 0;
+    }
+    
+    //Índice por ID (dono), fila do serviço, árvore de prioridades e índices de faixa
+    //para relatórios por ID e por período; se uma etapa falha, as anteriores são desfeitas
+    int etapas = 0;
+    if (inserir_indice_ocorrencia(sistema->indice_ocorrencias, nova)) etapas++;
+    if (etapas == 1 && enfileirar(fila_do_servico(sistema, tipo), nova)) etapas++;
+    if (etapas == 2 && inserir_prioridade(sistema->prioridades, nova)) etapas++;
+    if (etapas == 3 && inserir_bmais(sistema->faixas_por_id, nova)) etapas++;
+    if (etapas == 4 && inserir_bmais(sistema->faixas_por_tempo, nova)) etapas++;
+    
+    //O chamado pode ser despachado a partir do próximo tempo
+    if (etapas == 5 && agendar_despacho(sistema, tipo, sistema->tempo_atual + ATRASO_DESPACHO)) etapas++;
+    
+    if (etapas < 6) {
+        LOG_ERRO("Erro: Sem memoria para registrar a ocorrencia #%d!\n", nova->id);
+        desfazer_recebimento(sistema, nova, etapas);
+        return 0;
+    }
+    
+    //O ID só é consumido quando o registro se completa
+    sistema->proximo_id_ocorrencia++;
+    LOG_INFO("Ocorrencia #%d adicionada na fila de %s\n", nova->id, tipo_servico_string(tipo));
+    LOG_DEPURACAO("Ocorrencia #%d indexada por ID\n", nova->id);
+    LOG_DEPURACAO("Ocorrencia #%d priorizada no indice %s (gravidade %d)\n", nova->id, nome_indice_prioridades(), gravidade);
+    
+    return 1;
+}
+
+//Remove uma ocorrência de todas as estruturas do sistema em O(log n)
+//Retorna 1 se removeu e 0 se não existe
+int remover_ocorrencia_sistema(SistemaEmergencia* sistema, int id) {
+    Ocorrencia* ocorrencia = buscar_indice_ocorrencia(sistema->indice_ocorrencias, id);
+    if (!ocorrencia) return 0;
+    
+    if (ocorrencia->estado == OCORRENCIA_PENDENTE) {
+        //Sai da árvore de prioridades; na fila, a posição vira lápide, pois o handle
+        //guardado lá deixa de valer quando o índice libera a ocorrência
+        remover_prioridade(sistema->prioridades, ocorrencia);
+        descartar_da_fila(fila_do_servico(sistema, ocorrencia->tipo_servico), ocorrencia);
+    } else if (ocorrencia->estado == OCORRENCIA_CONCLUIDA) {
+        //O handle na fila de concluídas deixa de valer e é descartado depois
+        sistema->arquivo->concluidas_vivas--;
+    }
+    
+    //As árvores B+ só apontam para a ocorrência; o índice por ID a libera por último
+    remover_bmais(sistema->faixas_por_id, ocorrencia);
+    remover_bmais(sistema->faixas_por_tempo, ocorrencia);
+    return remover_indice_ocorrencia(sistema->indice_ocorrencias, id);
+}
+
+//Cancela uma ocorrência que ainda aguarda despacho (ex.: trote ou alarme falso)
+//Sai da fila em O(1) (lápide) e do índice por ID, da árvore de prioridades e das árvores B+ em O(log n)
+//Retorna 1 se cancelou, 0 se não existe e -1 se já foi despachada
+int cancelar_ocorrencia(SistemaEmergencia* sistema, int id) {
+    if (!sistema) return 0;
+    
+    Ocorrencia* ocorrencia = buscar_indice_ocorrencia(sistema->indice_ocorrencias, id);
+    if (!ocorrencia) return 0;
+    if (ocorrencia->estado != OCORRENCIA_PENDENTE) return -1;
+    
+    sistema->canceladas[ocorrencia->tipo_servico]++;
+    return remover_ocorrencia_sistema(sistema, id);
+}
+
+//Muda a gravidade de uma ocorrência que ainda aguarda despacho (ex.: triagem reavaliou o chamado)
+//Só a árvore de prioridades depende da gravidade: a ocorrência é reposicionada nela em O(log n),
+//e a fila, o índice por ID e as árvores B+ (chaveadas por ID e tempo) não mudam
+//Retorna 1 se reclassificou, 0 se não existe e -1 se a gravidade é inválida ou já foi despachada
+int reclassificar_ocorrencia(SistemaEmergencia* sistema, int id, int nova_gravidade) {
+    if (!sistema) return 0;
+    if (!gravidade_valida(nova_gravidade)) return -1;
+    
+    Ocorrencia* ocorrencia = buscar_indice_ocorrencia(sistema->indice_ocorrencias, id);
+    if (!ocorrencia) return 0;
+    if (ocorrencia->estado != OCORRENCIA_PENDENTE) return -1;
+    if (ocorrencia->gravidade == nova_gravidade) return 1;
+    
+    return reclassificar_prioridade(sistema->prioridades, ocorrencia, nova_gravidade);
+}
+
+//Aplica uma leva de reclassificações (ids[i] passa a ter gravidades[i])
+//Cada uma custa O(log n); as que falham são ignoradas sem interromper as demais
+//Retorna quantas foram aplicadas
+int reclassificar_lote(SistemaEmergencia* sistema, const int* ids, const int* gravidades, int quantidade) {
+    if (!sistema || !ids || !gravidades) return 0;
+    
+    int aplicadas = 0;
+    for (int i = 0; i < quantidade; i++) {
+        if (reclassificar_ocorrencia(sistema, ids[i], gravidades[i]) == 1) aplicadas++;
+    }
+    return aplicadas;
+}
+
+//Move para o arquivo as concluídas que a política de retenção manda tirar dos índices vivos
+//Saem na ordem de conclusão, então o custo é O(log n) por ocorrência arquivada
+//Retorna quantas foram arquivadas
+int aplicar_retencao(SistemaEmergencia* sistema) {
+    if (!sistema) return 0;
+    
+    ArquivoOcorrencias* arquivo = sistema->arquivo;
+    int arquivadas = 0;
+    Ocorrencia* ocorrencia;
+    
+    while ((ocorrencia = primeira_concluida(arquivo)) != NULL &&
+           retencao_expirou(arquivo, ocorrencia, sistema->tempo_atual)) {
+        if (!arquivar_ocorrencia(arquivo, ocorrencia)) break;
+        descartar_primeira_concluida(arquivo);
+        remover_ocorrencia_sistema(sistema, ocorrencia->id);
+        arquivadas++;
+    }
+    
+    return arquivadas;
+}
+
+//Define a política de retenção (RETENCAO_DESLIGADA desliga cada limite) e já a aplica
+void configurar_retencao(SistemaEmergencia* sistema, int idade_maxima, int maximo_concluidas) {
+    if (!sistema) return;
+    
+    sistema->arquivo->idade_maxima = idade_maxima < 0 ? RETENCAO_DESLIGADA : idade_maxima;
+    sistema->arquivo->maximo_concluidas = maximo_concluidas < 0 ? RETENCAO_DESLIGADA : maximo_concluidas;
+    
+    int arquivadas = aplicar_retencao(sistema);
+    LOG_INFO("Política de retenção atualizada (%d ocorrências arquivadas agora)\n", arquivadas);
+}
+
+//Retorna a fila do tipo de serviço
+Fila* fila_do_servico(SistemaEmergencia* sistema, TipoServico tipo) {
+    switch (tipo) {
+        case AMBULANCIA: return sistema->fila_ambulancia;
+        case BOMBEIRO: return sistema->fila_bombeiro;
+        case POLICIA: return sistema->fila_policia;
+        default: return NULL;
+    }
+}
+
+//Retira a próxima ocorrência a ser atendida de um serviço, conforme o modo de despacho
+//A ocorrência sai da fila e da árvore de prioridades no mesmo passo
+Ocorrencia* proxima_ocorrencia(SistemaEmergencia* sistema, TipoServico tipo) {
+    Fila* fila = fila_do_servico(sistema, tipo);
+    Ocorrencia* ocorrencia;
+    
+    if (sistema->modo_despacho == DESPACHO_PRIORIDADE) {
+        //Maior gravidade primeiro (empate: menor ID), em O(log n)
+        ocorrencia = extrair_prioridade(sistema->prioridades, tipo);
+        if (!ocorrencia) return NULL;
+        ocorrencia->estado = OCORRENCIA_EM_ATENDIMENTO;
+        descartar_da_fila(fila, ocorrencia);
+    } else {
+        ocorrencia = desenfileirar(fila);
+        if (!ocorrencia) return NULL;
+        ocorrencia->estado = OCORRENCIA_EM_ATENDIMENTO;
+        remover_prioridade(sistema->prioridades, ocorrencia);
+    }
+    
+    return ocorrencia;
+}
+
+//Retorna o nome do modo de despacho
+const char* modo_despacho_string(ModoDespacho modo) {
+    return modo == DESPACHO_PRIORIDADE ? "PRIORIDADE" : "FIFO";
+}
+
+//Conta nos histogramas a espera (despacho - chegada) do atendimento que começa agora
+void registrar_latencias_despacho(SistemaEmergencia* sistema, Ocorrencia* ocorrencia) {
+    registrar_latencias(sistema->latencias, ocorrencia->tipo_servico,
+                        slot_bairro_mapa(sistema->mapa_cidade, ocorrencia->bairro_id),
+                        sistema->tempo_atual - ocorrencia->tempo_chegada);
+}
+
+//Retorna a duração de um atendimento do serviço, do despacho até a conclusão
+int duracao_atendimento(TipoServico tipo) {
+    switch (tipo) {
+        case AMBULANCIA: return DURACAO_AMBULANCIA;
+        case BOMBEIRO: return DURACAO_BOMBEIRO;
+        case POLICIA: return DURACAO_POLICIA;
+        default: return 1;
+    }
+}
+
+//Retorna quanto do atendimento do serviço é gasto no deslocamento até o local
+int deslocamento_atendimento(TipoServico tipo) {
+    switch (tipo) {
+        case AMBULANCIA: return DESLOCAMENTO_AMBULANCIA;
+        case BOMBEIRO: return DESLOCAMENTO_BOMBEIRO;
+        case POLICIA: return DESLOCAMENTO_POLICIA;
+        default: return 0;
+    }
+}
+
+//Retorna a observação gravada no histórico de cada atendimento do serviço
+const char* observacao_atendimento(TipoServico tipo) {
+    switch (tipo) {
+        case AMBULANCIA: return "Atendimento médico";
+        case BOMBEIRO: return "Combate a incendio";
+        case POLICIA: return "Atendimento policial";
+        default: return "";
+    }
+}
+
+//Retorna o nome da unidade do serviço usado nas mensagens de despacho
+const char* nome_unidade_servico(TipoServico tipo) {
+    switch (tipo) {
+        case AMBULANCIA: return "Ambulancia";
+        case BOMBEIRO: return "Bombeiro";
+        case POLICIA: return "Policia";
+        default: return "Unidade";
+    }
+}
+
+//Agenda um despacho do serviço para o tempo dado, a menos que já haja um pendente para esse tempo
+//Os pedidos são para o tempo atual ou até ATRASO_DESPACHO depois, então cada tempo pendente tem sua posição
+int agendar_despacho(SistemaEmergencia* sistema, TipoServico tipo, int tempo) {
+    CalendarioEventos* calendario = sistema->calendario;
+    int* agendado = &calendario->despacho_agendado[tipo][tempo % (ATRASO_DESPACHO + 1)];
+    if (*agendado == tempo) return 1;
+    
+    EventoSimulacao evento = novo_evento(tempo, EVENTO_DESPACHO);
+    evento.servico = tipo;
+    if (!agendar_evento(calendario, evento)) return 0;
+    *agendado = tempo;
+    
+    return 1;
+}
+
+//Despacha a próxima ocorrência pendente do serviço para uma unidade livre
+//Retorna 1 se despachou e 0 se não há pendente, unidade livre ou espaço no calendário
+int despachar_ocorrencia(SistemaEmergencia* sistema, TipoServico tipo) {
+    if (fila_vazia(fila_do_servico(sistema, tipo))) return 0;
+    
+    //Reserva os dois eventos do atendimento antes de mexer na fila e na unidade: sem espaço, nada muda
+    if (!reservar_eventos(sistema->calendario, 2)) {
+        LOG_ERRO("Sem memoria para agendar o atendimento de %s\n", tipo_servico_string(tipo));
+        return 0;
+    }
+    
+    int unidade = ocupar_unidade_livre(sistema->unidades, tipo);
+    if (unidade < 0) return 0;
+    
+    Ocorrencia* ocorrencia = proxima_ocorrencia(sistema, tipo);
+    ocorrencia->tempo_fim = sistema->tempo_atual + duracao_atendimento(tipo);
+    registrar_latencias_despacho(sistema, ocorrencia);
+    
+    //Adiciona ao histórico
+    empilhar_historico(historico_do_servico(sistema, tipo), ocorrencia->id, 
+                     ocorrencia->bairro_id, ocorrencia->tipo_servico, 
+                     ocorrencia->gravidade, sistema->tempo_atual, 
+                     ocorrencia->tempo_fim, observacao_atendimento(tipo));
+    
+    //Agenda a chegada ao local e o fim do atendimento (o espaço já foi reservado)
+    EventoSimulacao evento = novo_evento(sistema->tempo_atual + deslocamento_atendimento(tipo), EVENTO_NO_LOCAL);
+    evento.ocorrencia_id = ocorrencia->id;
+    evento.unidade = unidade;
+    evento.bairro_id = ocorrencia->bairro_id;
+    evento.servico = tipo;
+    evento.tempo_inicio = sistema->tempo_atual;
+    agendar_evento(sistema->calendario, evento);
+    
+    evento.tempo = ocorrencia->tempo_fim;
+    evento.tipo = EVENTO_CONCLUSAO;
+    agendar_evento(sistema->calendario, evento);
+    
+    //Atualiza mapa da cidade: a unidade sai do bairro do chamado, se ele tinha alguma disponível
+    if (atualizar_unidades_disponiveis(sistema->mapa_cidade, ocorrencia->bairro_id, tipo, -1)) {
+        sistema->unidades->bairros_mapa[unidade] = ocorrencia->bairro_id;
+    }
+    
+    LOG_INFO("%s %s atendendo ocorrencia #%d no bairro %d\n", nome_unidade_servico(tipo),
+             sistema->unidades->identificacoes[unidade], ocorrencia->id, ocorrencia->bairro_id);
+    
+    return 1;
+}
+
+//Processa atendimentos das filas: despacha no máximo uma ocorrência de cada serviço agora
+void processar_atendimentos(SistemaEmergencia* sistema) {
+    if (!sistema) return;
+    
+    LOG_DEPURACAO("\n=== PROCESSANDO ATENDIMENTOS - Tempo %d ===\n", sistema->tempo_atual);
+    
+    for (int tipo = 0; tipo < NUM_TIPOS_SERVICO; tipo++) {
+        despachar_ocorrencia(sistema, (TipoServico)tipo);
+    }
+}
+
+//Marca a ocorrência do evento como concluída e agenda a volta da unidade
+void concluir_atendimento(SistemaEmergencia* sistema, EventoSimulacao evento) {
+    //A ocorrência atendida passa a valer para a política de retenção (se não foi removida antes)
+    Ocorrencia* ocorrencia = buscar_indice_ocorrencia(sistema->indice_ocorrencias, evento.ocorrencia_id);
+    if (ocorrencia) {
+        ocorrencia->estado = OCORRENCIA_CONCLUIDA;
+        registrar_concluida(sistema->arquivo, ocorrencia);
+        LOG_DEPURACAO("Ocorrencia #%d concluida\n", ocorrencia->id);
+    }
+    
+    //A duração vem do próprio evento, então conta mesmo se a ocorrência já saiu dos índices
+    registrar_duracao_atendimento(sistema->latencias, evento.servico,
+                                  slot_bairro_mapa(sistema->mapa_cidade, evento.bairro_id),
+                                  evento.tempo - evento.tempo_inicio);
+    
+    evento.tempo += TEMPO_RETORNO;
+    evento.tipo = EVENTO_UNIDADE_LIVRE;
+    if (!agendar_evento(sistema->calendario, evento)) {
+        //Sem espaço para o retorno, a unidade volta já em vez de ficar ocupada para sempre
+        LOG_ERRO("Sem memoria para agendar o retorno da unidade %s\n", sistema->unidades->identificacoes[evento.unidade]);
+        devolver_unidade(sistema, evento);
+    }
+}
+
+//Devolve a unidade do evento e tenta despachar a próxima pendente do seu serviço
+void devolver_unidade(SistemaEmergencia* sistema, EventoSimulacao evento) {
+    int unidade = evento.unidade;
+    TipoServico tipo = (TipoServico)sistema->unidades->tipos[unidade];
+    
+    devolver_unidade_livre(sistema->unidades, unidade);
+    //Atualiza mapa da cidade: a unidade volta a contar só no bairro de onde foi descontada
+    int* bairro_mapa = &sistema->unidades->bairros_mapa[unidade];
+    if (*bairro_mapa >= 0) {
+        atualizar_unidades_disponiveis(sistema->mapa_cidade, *bairro_mapa, tipo, 1);
+        *bairro_mapa = -1;
     }
+    LOG_INFO("Unidade %s ficou disponivel\n", sistema->unidades->identificacoes[unidade]);
     
-    Ocorrencia* nova = criar_ocorrencia(sistema->proximo_id_ocorrencia++, 
-                                       bairro_id, tipo, gravidade, 
-                                       sistema->tempo_atual);
-    
-    //Adiciona na fila correspondente
-    switch (tipo) {
-        case AMBULANCIA:
-            enfileirar(sistema->fila_ambulancia, nova);
-            printf("Ocorrencia #%d adicionada na fila de AMBULANCIA\n", nova->id);
+    if (!fila_vazia(fila_do_servico(sistema, tipo))) {
+        agendar_despacho(sistema, tipo, sistema->tempo_atual);
+    }
+}
+
+//Trata um evento retirado do calendário no tempo atual
+void tratar_evento(SistemaEmergencia* sistema, EventoSimulacao evento) {
+    switch (evento.tipo) {
+        case EVENTO_CONCLUSAO:
+            concluir_atendimento(sistema, evento);
+            break;
+        case EVENTO_UNIDADE_LIVRE:
+            devolver_unidade(sistema, evento);
             break;
-        case BOMBEIRO:
-            enfileirar(sistema->fila_bombeiro, nova);
-            printf("Ocorrencia #%d adicionada na fila de BOMBEIRO\n", nova->id);
+        case EVENTO_NO_LOCAL:
+            LOG_DEPURACAO("%s %s chegou ao local da ocorrencia #%d\n", nome_unidade_servico(evento.servico),
+                          sistema->unidades->identificacoes[evento.unidade], evento.ocorrencia_id);
             break;
-        case POLICIA:
-            enfileirar(sistema->fila_policia, nova);
-            printf("Ocorrencia #%d adicionada na fila de POLICIA\n", nova->id);
+        case EVENTO_CHEGADA:
+            receber_ocorrencia(sistema, evento.bairro_id, evento.servico, evento.gravidade);
+            break;
+        case EVENTO_DESPACHO:
+            //Despacha enquanto houver pendente e unidade livre, sem esperar o próximo tempo
+            sistema->calendario->despacho_agendado[evento.servico][evento.tempo % (ATRASO_DESPACHO + 1)] = -1;
+            while (despachar_ocorrencia(sistema, evento.servico));
             break;
     }
+}
+
+//Agenda um chamado para entrar no sistema no tempo dado (ou agora, se o tempo já passou)
+//Retorna 1 se o chamado foi agendado (ou registrado agora) e 0 se foi recusado
+int agendar_ocorrencia(SistemaEmergencia* sistema, int tempo, int bairro_id, TipoServico tipo, int gravidade) {
+    if (!sistema || !gravidade_valida(gravidade)) return 0;
     
-    //Adiciona nas árvores para consultas inteligentes
-    if (inserir_bst(sistema->arvore_ocorrencias, nova)) {
-        printf("Ocorrencia #%d indexada na arvore BST\n", nova->id);
+    if (tempo <= sistema->tempo_atual) {
+        return receber_ocorrencia(sistema, bairro_id, tipo, gravidade);
     }
     
-    if (inserir_avl_arvore(sistema->arvore_prioridades, nova)) {
-        printf("Ocorrencia #%d priorizada na arvore AVL (gravidade %d)\n", nova->id, gravidade);
-    }
+    EventoSimulacao evento = novo_evento(tempo, EVENTO_CHEGADA);
+    evento.bairro_id = bairro_id;
+    evento.servico = tipo;
+    evento.gravidade = gravidade;
+    
+    return agendar_evento(sistema->calendario, evento);
 }
 
-//Processa atendimentos das filas
-void processar_atendimentos(SistemaEmergencia* sistema) {
-    if (!sistema) return;
-    
-    printf("\n=== PROCESSANDO ATENDIMENTOS - Tempo %d ===\n", sistema->tempo_atual);
-    
-    //Processa fila de ambulâncias
-    if (!fila_vazia(sistema->fila_ambulancia)) {
-        UnidadeServico* ambulancia = buscar_unidade_disponivel(sistema->unidades, AMBULANCIA);
-        if (ambulancia) {
-            Ocorrencia* ocorrencia = desenfileirar(sistema->fila_ambulancia);
-            ambulancia->disponivel = 0;  //Marca como ocupado
-            
-            //Adiciona ao histórico
-            empilhar_historico(sistema->historico_ambulancia, ocorrencia->id, 
-                             ocorrencia->bairro_id, ocorrencia->tipo_servico, 
-                             ocorrencia->gravidade, sistema->tempo_atual, 
-                             sistema->tempo_atual + 2, "Atendimento médico");
-            
-            //Atualiza mapa da cidade
-            atualizar_unidades_disponiveis(sistema->mapa_cidade, ocorrencia->bairro_id, AMBULANCIA, -1);
-            
-            printf("Ambulancia %s atendendo ocorrencia #%d no bairro %d\n", 
-                   ambulancia->identificacao, ocorrencia->id, ocorrencia->bairro_id);
-            free(ocorrencia);
-        }
+//Gerador do tráfego sintético (xorshift64*), com estado próprio semeado por gerar_trafego para execuções repetíveis
+uint64_t proximo_aleatorio_trafego(uint64_t* estado) {
+    *estado ^= *estado >> 12;
+    *estado ^= *estado << 25;
+    *estado ^= *estado >> 27;
+    return *estado * 2685821657736338717ULL;
+}
+
+//Agenda chamados sintéticos espalhados pelos próximos duracao tempos, em bairros, serviços e
+//gravidades sorteados (semente fixa, para execuções repetíveis). Retorna quantos foram agendados
+int gerar_trafego(SistemaEmergencia* sistema, int chamadas, int duracao, uint64_t semente) {
+    if (!sistema || chamadas <= 0 || duracao <= 0) return 0;
+    
+    ListaCruzada* mapa = sistema->mapa_cidade;
+    if (mapa->quantidade == 0) {
+        LOG_ERRO("Nenhum bairro cadastrado para gerar tráfego!\n");
+        return 0;
     }
     
-    //Processa fila de bombeiros
-    if (!fila_vazia(sistema->fila_bombeiro)) {
-        UnidadeServico* bombeiro = buscar_unidade_disponivel(sistema->unidades, BOMBEIRO);
-        if (bombeiro) {
-            Ocorrencia* ocorrencia = desenfileirar(sistema->fila_bombeiro);
-            bombeiro->disponivel = 0;
-            
-            //Adiciona ao histórico
-            empilhar_historico(sistema->historico_bombeiro, ocorrencia->id, 
-                             ocorrencia->bairro_id, ocorrencia->tipo_servico, 
-                             ocorrencia->gravidade, sistema->tempo_atual, 
-                             sistema->tempo_atual + 3, "Combate a incendio");
-            
-            //Atualiza mapa da cidade
-            atualizar_unidades_disponiveis(sistema->mapa_cidade, ocorrencia->bairro_id, BOMBEIRO, -1);
-            
-            printf("Bombeiro %s atendendo ocorrencia #%d no bairro %d\n", 
-                   bombeiro->identificacao, ocorrencia->id, ocorrencia->bairro_id);
-            free(ocorrencia);
-        }
+    uint64_t estado = semente ? semente : SEMENTE_TRAFEGO;
+    int agendados = 0;
+    for (int i = 0; i < chamadas; i++) {
+        int tempo = sistema->tempo_atual + 1 + (int)(proximo_aleatorio_trafego(&estado) % (uint64_t)duracao);
+        int bairro_id = mapa->bairros[proximo_aleatorio_trafego(&estado) % (uint64_t)mapa->quantidade]->bairro_id;
+        TipoServico tipo = (TipoServico)(proximo_aleatorio_trafego(&estado) % NUM_TIPOS_SERVICO);
+        int gravidade = 1 + (int)(proximo_aleatorio_trafego(&estado) % NIVEIS_GRAVIDADE);
+        
+        agendados += agendar_ocorrencia(sistema, tempo, bairro_id, tipo, gravidade);
     }
     
-    //Processa fila de polícia
-    if (!fila_vazia(sistema->fila_policia)) {
-        UnidadeServico* policia = buscar_unidade_disponivel(sistema->unidades, POLICIA);
-        if (policia) {
-            Ocorrencia* ocorrencia = desenfileirar(sistema->fila_policia);
-            policia->disponivel = 0;
-            
-            //Adiciona ao histórico
-            empilhar_historico(sistema->historico_policia, ocorrencia->id, 
-                             ocorrencia->bairro_id, ocorrencia->tipo_servico, 
-                             ocorrencia->gravidade, sistema->tempo_atual, 
-                             sistema->tempo_atual + 1, "Atendimento policial");
-            
-            //Atualiza mapa da cidade
-            atualizar_unidades_disponiveis(sistema->mapa_cidade, ocorrencia->bairro_id, POLICIA, -1);
-            
-            printf("Policia %s atendendo ocorrencia #%d no bairro %d\n", 
-                   policia->identificacao, ocorrencia->id, ocorrencia->bairro_id);
-            free(ocorrencia);
-        }
-    }
+    LOG_INFO("%d chamados agendados entre os tempos %d e %d\n", agendados,
+             sistema->tempo_atual + 1, sistema->tempo_atual + duracao);
+    return agendados;
 }
 
-//Simula passagem do tempo
+//Simula passagem do tempo: salta direto de um evento do calendário para o próximo,
+//então o custo depende só da quantidade de eventos, não da quantidade de unidades de tempo
 void simular_tempo(SistemaEmergencia* sistema, int unidades_tempo) {
     if (!sistema) return;
     
-    for (int i = 0; i < unidades_tempo; i++) {
-        sistema->tempo_atual++;
-        
-        //Libera algumas unidades aleatoriamente (simulação simples)
-        UnidadeServico* atual = sistema->unidades;
-        while (atual) {
-            if (!atual->disponivel && (sistema->tempo_atual % 3 == 0)) {
-                atual->disponivel = 1;
-                //Atualiza mapa da cidade
-                adicionar_servico_bairro(sistema->mapa_cidade, 1, atual->tipo); // Simula retorno ao centro
-                printf("Unidade %s ficou disponivel\n", atual->identificacao);
-            }
-            atual = atual->prox;
+    CalendarioEventos* calendario = sistema->calendario;
+    int tempo_final = sistema->tempo_atual + unidades_tempo;
+    int proximo;
+    
+    while ((proximo = proximo_evento(calendario)) >= 0 && proximo <= tempo_final) {
+        if (proximo > sistema->tempo_atual) {
+            sistema->tempo_atual = proximo;
+            LOG_DEPURACAO("\n=== EVENTOS - Tempo %d ===\n", sistema->tempo_atual);
         }
         
-        processar_atendimentos(sistema);
+        //Trata todos os eventos deste tempo, inclusive os que eles mesmos agendam para agora
+        while ((proximo = proximo_evento(calendario)) >= 0 && proximo <= sistema->tempo_atual) {
+            tratar_evento(sistema, retirar_evento(calendario));
+        }
+        aplicar_retencao(sistema);
+    }
+    
+    if (tempo_final > sistema->tempo_atual) {
+        sistema->tempo_atual = tempo_final;
     }
+    //Os tempos sem eventos também contam para a idade das concluídas
+    aplicar_retencao(sistema);
 }
 
 //Mostra status geral do sistema
@@ -1435,6 +4478,9 @@ void status_sistema(SistemaEmergencia* sistema) {
     printf("\n============ STATUS DO SISTEMA ============\n");
     printf("Tempo atual: %d\n", sistema->tempo_atual);
     printf("Próximo ID de ocorrência: %d\n", sistema->proximo_id_ocorrencia);
+    printf("Modo de despacho: %s\n", modo_despacho_string(sistema->modo_despacho));
+    printf("Eventos agendados: %d | Eventos tratados: %lld\n",
+           sistema->calendario->tamanho, sistema->calendario->processados);
     
     listar_bairros(sistema->bairros);
     listar_unidades(sistema->unidades);
@@ -1452,11 +4498,18 @@ void status_sistema(SistemaEmergencia* sistema) {
     printf("Ambulâncias - Atendimentos realizados: %d\n", sistema->historico_ambulancia->tamanho);
     printf("Bombeiros - Atendimentos realizados: %d\n", sistema->historico_bombeiro->tamanho);
     printf("Polícia - Atendimentos realizados: %d\n", sistema->historico_policia->tamanho);
+    printf("Ocorrências canceladas antes do despacho: %d ambulância, %d bombeiro, %d polícia\n",
+           sistema->canceladas[AMBULANCIA], sistema->canceladas[BOMBEIRO], sistema->canceladas[POLICIA]);
+    
+    printf("\n=== TEMPOS DE RESPOSTA (unidades de tempo) ===\n");
+    mostrar_latencias_servicos(sistema->latencias);
     
     //Mostra estatísticas das árvores
     printf("\n=== ESTRUTURAS INTELIGENTES ===\n");
-    printf("BST - Ocorrências indexadas: %d\n", sistema->arvore_ocorrencias->tamanho);
-    printf("AVL - Ocorrências priorizadas: %d\n", sistema->arvore_prioridades->tamanho);
+    printf("Índice por ID - Ocorrências indexadas: %d\n", sistema->indice_ocorrencias->tamanho);
+    printf("%s - Ocorrências priorizadas: %d\n", nome_indice_prioridades(), sistema->prioridades->tamanho);
+    printf("B+ - Faixas por ID/tempo: %d/%d (altura %d)\n", sistema->faixas_por_id->tamanho,
+           sistema->faixas_por_tempo->tamanho, sistema->faixas_por_id->altura);
     
     printf("==========================================\n");
 }
@@ -1467,7 +4520,8 @@ void liberar_sistema(SistemaEmergencia* sistema) {
     
     liberar_tabela_bairros(sistema->bairros);
     liberar_tabela_cidadaos(sistema->cidadaos);
-    liberar_unidades(sistema->unidades);
+    liberar_registro_unidades(sistema->unidades);
+    liberar_calendario_eventos(sistema->calendario);
     liberar_pilha_historico(sistema->historico_ambulancia);
     liberar_pilha_historico(sistema->historico_bombeiro);
     liberar_pilha_historico(sistema->historico_policia);
@@ -1475,9 +4529,18 @@ void liberar_sistema(SistemaEmergencia* sistema) {
     liberar_fila(sistema->fila_ambulancia);
     liberar_fila(sistema->fila_bombeiro);
     liberar_fila(sistema->fila_policia);
-    liberar_bst_completa(sistema->arvore_ocorrencias);
-    liberar_avl_completa(sistema->arvore_prioridades);
+    liberar_indice_ocorrencias(sistema->indice_ocorrencias);
+    liberar_indice_prioridades(sistema->prioridades);
+    liberar_arvore_bmais(sistema->faixas_por_id);
+    liberar_arvore_bmais(sistema->faixas_por_tempo);
+    liberar_arquivo_ocorrencias(sistema->arquivo);
+    liberar_painel_latencias(sistema->latencias);
     free(sistema);
+    
+    //Último sistema encerrado: devolve os blocos dos pools ao sistema operacional
+    if (--sistemas_ativos == 0) {
+        liberar_pools();
+    }
 }
 
 // ==================== IMPLEMENTAÇÃO - FUNÇÕES AUXILIARES DE INTERFACE ====================
@@ -1559,6 +4622,8 @@ void menu_configuracao(SistemaEmergencia* sistema) {
         printf("7. Adicionar Unidade de Serviço\n");
         printf("8. Listar Unidades\n");
         printf("9. Ver Mapa da Cidade\n");
+        printf("10. Alternar Modo de Despacho (atual: %s)\n", modo_despacho_string(sistema->modo_despacho));
+        printf("11. Política de Retenção das Concluídas\n");
         printf("0. Voltar ao menu principal\n");
         printf("Escolha uma opcao: ");
         
@@ -1628,6 +4693,18 @@ void menu_configuracao(SistemaEmergencia* sistema) {
             case 9:
                 mostrar_mapa_cidade(sistema->mapa_cidade);
                 break;
+            case 10:
+                sistema->modo_despacho = sistema->modo_despacho == DESPACHO_FIFO ?
+                                         DESPACHO_PRIORIDADE : DESPACHO_FIFO;
+                printf("Modo de despacho: %s\n", modo_despacho_string(sistema->modo_despacho));
+                break;
+            case 11: {
+                mostrar_resumo_arquivo(sistema->arquivo);
+                int idade = ler_inteiro("Idade máxima após o fim (-1 = sem limite): ");
+                int maximo = ler_inteiro("Máximo de concluídas nos índices (-1 = sem limite): ");
+                configurar_retencao(sistema, idade, maximo);
+                break;
+            }
             case 0:
                 printf("Voltando ao menu principal...\n");
                 break;
@@ -1657,8 +4734,11 @@ void menu_consultas(SistemaEmergencia* sistema) {
         printf("6. Mapa Completo da Cidade\n");
         printf("7. Estatísticas Gerais\n");
         printf("\nBuscas Inteligentes:\n");
-        printf("8. Busca Rápida por ID (BST)\n");
+        printf("8. Busca Rápida por ID\n");
         printf("9. Consulta por Prioridade (AVL)\n");
+        printf("\nTempos de Resposta:\n");
+        printf("10. Tempos de Resposta por Serviço e por Bairro\n");
+        printf("11. Exportar Tempos de Resposta (CSV)\n");
         printf("0. Voltar ao menu principal\n");
         printf("Escolha uma opção: ");
         
@@ -1674,9 +4754,11 @@ void menu_consultas(SistemaEmergencia* sistema) {
                 ler_string("Digite o CPF: ", cpf, sizeof(cpf));
                 Cidadao* cidadao = buscar_cidadao(sistema->cidadaos, cpf);
                 if (cidadao) {
+                    char cpf_formatado[MAX_CPF];
+                    formatar_cpf(cidadao->cpf, cpf_formatado);
                     printf("\n=== CIDADÃO ENCONTRADO ===\n");
                     printf("Nome: %s\n", cidadao->nome);
-                    printf("CPF: %s\n", cidadao->cpf);
+                    printf("CPF: %s\n", cpf_formatado);
                     printf("Email: %s\n", cidadao->email);
                     printf("Endereço: %s\n", cidadao->endereco);
                     printf("Bairro ID: %d\n", cidadao->bairro_id);
@@ -1722,20 +4804,24 @@ void menu_consultas(SistemaEmergencia* sistema) {
                                         sistema->historico_bombeiro->tamanho + 
                                         sistema->historico_policia->tamanho);
                 printf("Tempo atual do sistema: %d\n", sistema->tempo_atual);
-                printf("Ocorrências na BST: %d\n", sistema->arvore_ocorrencias->tamanho);
-                printf("Ocorrências na AVL: %d\n", sistema->arvore_prioridades->tamanho);
+                printf("Ocorrências indexadas por ID: %d\n", sistema->indice_ocorrencias->tamanho);
+                printf("Ocorrências priorizadas (%s): %d\n", nome_indice_prioridades(), sistema->prioridades->tamanho);
+                printf("Ocorrências arquivadas (concluídas): %d\n", sistema->arquivo->quantidade);
                 break;
             }
             case 8: {
                 int id = ler_inteiro("Digite o ID da ocorrência: ");
-                printf("\nBUSCA INTELIGENTE (BST):\n");
-                Ocorrencia* ocorrencia = buscar_ocorrencia_por_id(sistema->arvore_ocorrencias, id);
+                printf("\nBUSCA RÁPIDA (ÍNDICE POR ID):\n");
+                Ocorrencia* ocorrencia = buscar_indice_ocorrencia(sistema->indice_ocorrencias, id);
                 if (ocorrencia) {
-                    printf("Encontrada em O(log n)!\n");
+                    printf("Encontrada em O(1)!\n");
                     printf("ID: %d | Bairro: %d | %s | Gravidade: %d\n",
                            ocorrencia->id, ocorrencia->bairro_id,
                            tipo_servico_string(ocorrencia->tipo_servico),
                            ocorrencia->gravidade);
+                } else if (buscar_arquivo_ocorrencia(sistema->arquivo, id)) {
+                    printf("Encontrada no arquivo de concluídas:\n");
+                    mostrar_ocorrencia_arquivada(buscar_arquivo_ocorrencia(sistema->arquivo, id));
                 } else {
                     printf("Ocorrência não encontrada!\n");
                 }
@@ -1744,7 +4830,18 @@ void menu_consultas(SistemaEmergencia* sistema) {
             case 9: {
                 printf("\nCONSULTA POR PRIORIDADE (AVL):\n");
                 printf("Ocorrências ordenadas por gravidade:\n");
-                mostrar_ocorrencias_por_prioridade(sistema->arvore_prioridades);
+                mostrar_prioridades(sistema->prioridades);
+                break;
+            }
+            case 10:
+                printf("\n=== TEMPOS DE RESPOSTA POR SERVIÇO ===\n");
+                mostrar_latencias_servicos(sistema->latencias);
+                mostrar_latencias_bairros(sistema->latencias, sistema->mapa_cidade);
+                break;
+            case 11: {
+                char arquivo[MAX_NOME];
+                ler_string("Arquivo CSV: ", arquivo, MAX_NOME);
+                exportar_latencias(sistema->latencias, sistema->mapa_cidade, arquivo);
                 break;
             }
             case 0:
@@ -1768,18 +4865,30 @@ void menu_arvores(SistemaEmergencia* sistema) {
     do {
         printf("\n=== CONSULTAS COM ÁRVORES ===\n");
         printf("Busca Inteligente:\n");
-        printf("1. Buscar Ocorrência por ID (BST)\n");
-        printf("2. Listar Todas as Ocorrências por ID (BST)\n");
-        printf("3. Consultar por Prioridade (AVL)\n");
-        printf("4. Mostrar Estrutura da Árvore BST\n");
-        printf("5. Mostrar Estrutura da Árvore AVL\n");
+        printf("1. Buscar Ocorrência por ID (Índice)\n");
+        printf("2. Listar Todas as Ocorrências por ID (Índice)\n");
+        printf("3. Consultar por Prioridade (%s)\n", nome_indice_prioridades());
+        printf("4. Mostrar Estrutura do Índice por ID\n");
+        printf("5. Mostrar Estrutura do Índice de Prioridades (%s)\n", nome_indice_prioridades());
         printf("\nOperações Avançadas:\n");
-        printf("6. Remover Ocorrência por ID (BST)\n");
-        printf("7. Buscar por Gravidade (AVL)\n");
+        printf("6. Remover Ocorrência por ID (Índice)\n");
+        printf("7. Buscar por Gravidade (%s)\n", nome_indice_prioridades());
         printf("8. Estatísticas das Árvores\n");
         printf("\nTestes de Performance:\n");
-        printf("9. Teste de Busca Sequencial vs BST\n");
-        printf("10. Demonstração de Balanceamento AVL\n");
+        printf("9. Benchmark: Busca Sequencial vs BST vs AVL\n");
+        printf("10. Demonstração do Índice de Prioridades (%s)\n", nome_indice_prioridades());
+        printf("\nRelatórios por Faixa (B+):\n");
+        printf("11. Ocorrências por Faixa de ID\n");
+        printf("12. Chegadas por Faixa de Tempo\n");
+        printf("\nPainel de Prioridades (%s):\n", nome_indice_prioridades());
+        printf("13. Posição de uma Ocorrência na Ordem de Prioridade\n");
+        printf("14. k-ésima Ocorrência Mais Urgente\n");
+        printf("15. Pendentes por Faixa de Gravidade\n");
+        printf("\nArquivo de Concluídas:\n");
+        printf("16. Concluídas Arquivadas por Faixa de Tempo de Fim\n");
+        printf("\nOperações:\n");
+        printf("17. Cancelar Ocorrência Pendente (trote/alarme falso)\n");
+        printf("18. Reclassificar Gravidade de Ocorrência Pendente\n");
         printf("0. Voltar ao menu principal\n");
         printf("Escolha uma opção: ");
         
@@ -1792,8 +4901,8 @@ void menu_arvores(SistemaEmergencia* sistema) {
         switch (opcao) {
             case 1: {
                 int id = ler_inteiro("Digite o ID da ocorrência: ");
-                printf("\nBUSCA INTELIGENTE (BST) - Complexidade O(log n):\n");
-                Ocorrencia* ocorrencia = buscar_ocorrencia_por_id(sistema->arvore_ocorrencias, id);
+                printf("\nBUSCA RÁPIDA (ÍNDICE POR ID) - Complexidade O(1):\n");
+                Ocorrencia* ocorrencia = buscar_indice_ocorrencia(sistema->indice_ocorrencias, id);
                 if (ocorrencia) {
                     printf("Ocorrência encontrada rapidamente!\n");
                     printf("--------------------------------------------\n");
@@ -1803,6 +4912,9 @@ void menu_arvores(SistemaEmergencia* sistema) {
                     printf("Gravidade: %d\n", ocorrencia->gravidade);
                     printf("Tempo de Chegada: %d\n", ocorrencia->tempo_chegada);
                     printf("--------------------------------------------\n");
+                } else if (buscar_arquivo_ocorrencia(sistema->arquivo, id)) {
+                    printf("Ocorrência já concluída e arquivada:\n");
+                    mostrar_ocorrencia_arquivada(buscar_arquivo_ocorrencia(sistema->arquivo, id));
                 } else {
                     printf("Ocorrência com ID %d não encontrada!\n", id);
                 }
@@ -1810,38 +4922,39 @@ void menu_arvores(SistemaEmergencia* sistema) {
             }
             case 2:
                 printf("\nTODAS AS OCORRÊNCIAS ORDENADAS POR ID:\n");
-                mostrar_arvore_ordenada_por_id(sistema->arvore_ocorrencias);
+                mostrar_indice_ocorrencias(sistema->indice_ocorrencias);
                 break;
             case 3:
-                printf("\nCONSULTA POR PRIORIDADE (AVL):\n");
-                printf("Árvore auto-balanceada para máxima eficiência!\n");
-                mostrar_ocorrencias_por_prioridade(sistema->arvore_prioridades);
+                printf("\nCONSULTA POR PRIORIDADE (%s):\n", nome_indice_prioridades());
+                mostrar_prioridades(sistema->prioridades);
                 break;
             case 4:
-                printf("\nESTRUTURA COMPLETA DA ÁRVORE BST:\n");
-                mostrar_arvore_bst(sistema->arvore_ocorrencias);
+                printf("\nESTRUTURA COMPLETA DO ÍNDICE POR ID:\n");
+                mostrar_estrutura_indice(sistema->indice_ocorrencias);
                 break;
             case 5:
-                printf("\nESTRUTURA COMPLETA DA ÁRVORE AVL:\n");
-                mostrar_arvore_avl(sistema->arvore_prioridades);
+                printf("\nESTRUTURA COMPLETA DO ÍNDICE DE PRIORIDADES (%s):\n", nome_indice_prioridades());
+                mostrar_estrutura_prioridades(sistema->prioridades);
                 break;
             case 6: {
                 int id = ler_inteiro("Digite o ID da ocorrência para remover: ");
-                if (remover_ocorrencia_bst(sistema->arvore_ocorrencias, id)) {
-                    printf("Ocorrência #%d removida da BST com sucesso!\n", id);
+                if (remover_ocorrencia_sistema(sistema, id)) {
+                    printf("Ocorrência #%d removida do sistema com sucesso!\n", id);
                 } else {
                     printf("Ocorrência #%d não encontrada para remoção!\n", id);
                 }
                 break;
             }
             case 7: {
-                int gravidade = ler_inteiro("Digite a gravidade para buscar (1-3): ");
-                if (gravidade < 1 || gravidade > 3) {
-                    printf("Gravidade deve estar entre 1 e 3!\n");
+                char mensagem[64];
+                snprintf(mensagem, sizeof(mensagem), "Digite a gravidade para buscar (1-%d): ", NIVEIS_GRAVIDADE);
+                int gravidade = ler_inteiro(mensagem);
+                if (!gravidade_valida(gravidade)) {
+                    printf("Gravidade deve estar entre 1 e %d!\n", NIVEIS_GRAVIDADE);
                     break;
                 }
-                printf("\nBUSCA POR GRAVIDADE %d (AVL):\n", gravidade);
-                Ocorrencia* ocorrencia = buscar_por_gravidade(sistema->arvore_prioridades, gravidade);
+                printf("\nBUSCA POR GRAVIDADE %d (%s):\n", gravidade, nome_indice_prioridades());
+                Ocorrencia* ocorrencia = buscar_prioridade_por_gravidade(sistema->prioridades, gravidade);
                 if (ocorrencia) {
                     printf("Encontrada ocorrência com gravidade %d:\n", gravidade);
                     printf("ID: %d | Bairro: %d | %s\n", 
@@ -1855,48 +4968,140 @@ void menu_arvores(SistemaEmergencia* sistema) {
             case 8: {
                 printf("\nESTATÍSTICAS DAS ÁRVORES:\n");
                 printf("--------------------------------------------\n");
-                printf("BST (Busca por ID):\n");
-                printf("   • Ocorrências indexadas: %d\n", sistema->arvore_ocorrencias->tamanho);
-                printf("   • Complexidade de busca: O(log n) médio\n");
+                printf("Índice por ID (vetor em blocos):\n");
+                printf("   • Ocorrências indexadas: %d\n", sistema->indice_ocorrencias->tamanho);
+                printf("   • Complexidade de busca: O(1)\n");
                 printf("   • Uso: Consultas rápidas por ID\n\n");
-                printf("AVL (Priorização):\n");
-                printf("   • Ocorrências priorizadas: %d\n", sistema->arvore_prioridades->tamanho);
-                printf("   • Complexidade de busca: O(log n) garantido\n");
+                printf("%s (Priorização):\n", nome_indice_prioridades());
+                printf("   • Ocorrências priorizadas: %d\n", sistema->prioridades->tamanho);
+                printf("   • Complexidade de busca: %s\n", complexidade_indice_prioridades());
                 printf("   • Uso: Ordenação automática por gravidade\n");
-                printf("   • Balanceamento: Automático\n");
                 printf("--------------------------------------------\n");
                 break;
             }
             case 9: {
-                printf("\nTESTE DE PERFORMANCE: Busca Sequencial vs BST\n");
+                printf("\nBENCHMARK: Busca Sequencial vs BST vs AVL\n");
                 printf("--------------------------------------------\n");
-                if (sistema->arvore_ocorrencias->tamanho > 0) {
-                    printf("Simulando busca em %d ocorrências...\n", sistema->arvore_ocorrencias->tamanho);
-                    printf("Busca Sequencial: O(n) = %d comparações\n", sistema->arvore_ocorrencias->tamanho);
-                    printf("Busca BST: O(log n) ≈ %.1f comparações\n", 
-                           sistema->arvore_ocorrencias->tamanho > 1 ? 
-                           log2(sistema->arvore_ocorrencias->tamanho) : 1.0);
-                    printf("Melhoria: %.1fx mais rápido!\n", 
-                           sistema->arvore_ocorrencias->tamanho > 1 ? 
-                           (float)sistema->arvore_ocorrencias->tamanho / log2(sistema->arvore_ocorrencias->tamanho) : 1.0);
-                } else {
-                    printf("Nenhuma ocorrência cadastrada para teste!\n");
-                }
+                //Pelo menu roda um tamanho só; a série até 10^7 fica com "./benchmark arvores 0 M"
+                char mensagem[128];
+                snprintf(mensagem, sizeof(mensagem), "Tamanho N (%d a %d, 0 = %d): ",
+                         BENCHMARK_TAMANHO_MINIMO, BENCHMARK_TAMANHO_MAXIMO, BENCHMARK_N_MENU);
+                int n = ler_inteiro(mensagem);
+                snprintf(mensagem, sizeof(mensagem), "Operações M de cada tipo (busca, inserção, remoção; 0 = %d): ",
+                         BENCHMARK_M_MENU);
+                int m = ler_inteiro(mensagem);
+                char arquivo[MAX_NOME];
+                ler_string("Arquivo CSV (vazio para não exportar): ", arquivo, MAX_NOME);
+                benchmark_arvores(n > 0 ? n : BENCHMARK_N_MENU, m > 0 ? m : BENCHMARK_M_MENU, arquivo, stdout);
                 printf("--------------------------------------------\n");
                 break;
             }
             case 10: {
-                printf("\nDEMONSTRAÇÃO DE BALANCEAMENTO AVL:\n");
+                printf("\nDEMONSTRAÇÃO DO ÍNDICE DE PRIORIDADES (%s):\n", nome_indice_prioridades());
                 printf("--------------------------------------------\n");
+#ifdef PRIORIDADES_BALDES
+                printf("Um balde FIFO por serviço e gravidade, sem rebalanceamento!\n");
+                printf("• O mais urgente é o início do balde não vazio de maior gravidade\n");
+                printf("• Inserção, remoção e extração custam O(1)\n\n");
+#else
                 printf("A árvore AVL se rebalanceia automaticamente!\n");
                 printf("Cada nó mostra seu Fator de Balanceamento (FB):\n");
                 printf("• FB = altura(esquerda) - altura(direita)\n");
                 printf("• FB ∈ {-1, 0, 1} garante balanceamento\n");
                 printf("• Rotações automáticas mantêm a eficiência\n\n");
-                mostrar_arvore_avl(sistema->arvore_prioridades);
+#endif
+                mostrar_estrutura_prioridades(sistema->prioridades);
                 printf("--------------------------------------------\n");
                 break;
             }
+            case 11: {
+                int de = ler_inteiro("ID inicial: ");
+                int ate = ler_inteiro("ID final: ");
+                printf("\nOCORRÊNCIAS COM ID ENTRE %d E %d (B+):\n", de, ate);
+                mostrar_faixa_bmais(sistema->faixas_por_id, de, ate);
+                break;
+            }
+            case 12: {
+                int de = ler_inteiro("Tempo inicial: ");
+                int ate = ler_inteiro("Tempo final: ");
+                printf("\nCHEGADAS ENTRE OS TEMPOS %d E %d (B+):\n", de, ate);
+                mostrar_faixa_bmais(sistema->faixas_por_tempo, de, ate);
+                break;
+            }
+            case 13: {
+                int id = ler_inteiro("Digite o ID da ocorrência: ");
+                Ocorrencia* ocorrencia = buscar_indice_ocorrencia(sistema->indice_ocorrencias, id);
+                int posicao = posicao_prioridade(sistema->prioridades, ocorrencia);
+                if (posicao > 0) {
+                    printf("Ocorrência #%d é a %dª de %d na ordem de prioridade\n",
+                           id, posicao, sistema->prioridades->tamanho);
+                } else {
+                    printf("Ocorrência #%d não está pendente!\n", id);
+                }
+                break;
+            }
+            case 14: {
+                int k = ler_inteiro("Digite a posição k (1 = mais urgente): ");
+                Ocorrencia* ocorrencia = k_esima_prioridade(sistema->prioridades, k);
+                if (ocorrencia) {
+                    printf("%dª ocorrência mais urgente:\n", k);
+                    mostrar_ocorrencia(ocorrencia);
+                } else {
+                    printf("Não há %d ocorrências pendentes!\n", k);
+                }
+                break;
+            }
+            case 15: {
+                char mensagem[64];
+                snprintf(mensagem, sizeof(mensagem), "Gravidade mínima (1-%d): ", NIVEIS_GRAVIDADE);
+                int gravidade_min = ler_inteiro(mensagem);
+                snprintf(mensagem, sizeof(mensagem), "Gravidade máxima (1-%d): ", NIVEIS_GRAVIDADE);
+                int gravidade_max = ler_inteiro(mensagem);
+                if (!gravidade_valida(gravidade_min) || !gravidade_valida(gravidade_max)) {
+                    printf("Gravidade deve estar entre 1 e %d!\n", NIVEIS_GRAVIDADE);
+                    break;
+                }
+                printf("Pendentes com gravidade entre %d e %d: %d\n", gravidade_min, gravidade_max,
+                       contar_prioridades_gravidade(sistema->prioridades, gravidade_min, gravidade_max));
+                break;
+            }
+            case 16: {
+                mostrar_resumo_arquivo(sistema->arquivo);
+                int de = ler_inteiro("Fim a partir do tempo: ");
+                int ate = ler_inteiro("Fim até o tempo: ");
+                mostrar_faixa_arquivo(sistema->arquivo, de, ate);
+                break;
+            }
+            case 17: {
+                int id = ler_inteiro("Digite o ID da ocorrência a cancelar: ");
+                int resultado = cancelar_ocorrencia(sistema, id);
+                if (resultado > 0) {
+                    printf("Ocorrência #%d cancelada e retirada da fila e dos índices!\n", id);
+                } else if (resultado < 0) {
+                    printf("Ocorrência #%d já foi despachada e não pode ser cancelada!\n", id);
+                } else {
+                    printf("Ocorrência #%d não encontrada!\n", id);
+                }
+                break;
+            }
+            case 18: {
+                int id = ler_inteiro("Digite o ID da ocorrência: ");
+                char mensagem[64];
+                snprintf(mensagem, sizeof(mensagem), "Nova gravidade (1-%d): ", NIVEIS_GRAVIDADE);
+                int gravidade = ler_inteiro(mensagem);
+                int resultado = reclassificar_ocorrencia(sistema, id, gravidade);
+                if (resultado > 0) {
+                    printf("Ocorrência #%d agora tem gravidade %d!\n", id, gravidade);
+                    printf("Nova posição na prioridade: %d de %d\n",
+                           posicao_prioridade(sistema->prioridades, buscar_indice_ocorrencia(sistema->indice_ocorrencias, id)),
+                           sistema->prioridades->tamanho);
+                } else if (resultado < 0) {
+                    printf("Gravidade inválida ou ocorrência #%d já despachada!\n", id);
+                } else {
+                    printf("Ocorrência #%d não encontrada!\n", id);
+                }
+                break;
+            }
             case 0:
                 printf("Voltando ao menu principal...\n");
                 break;
@@ -1910,6 +5115,334 @@ void menu_arvores(SistemaEmergencia* sistema) {
     } while (opcao != 0);
 }
 
+// ==================== IMPLEMENTAÇÃO - BENCHMARK DAS ÁRVORES ====================
+
+//Gerador pseudoaleatório com estado explícito (xorshift64*), para execuções repetíveis
+uint64_t proximo_aleatorio_benchmark(uint64_t* estado) {
+    *estado ^= *estado >> 12;
+    *estado ^= *estado << 25;
+    *estado ^= *estado >> 27;
+    return *estado * 2685821657736338717ULL;
+}
+
+//Comparações feitas pelos comparadores que contam (a BST e a AVL do sistema não contam nada)
+long long comparacoes_arvores = 0;
+
+//Compara um ID com o de um nó da BST, contando a comparação
+int comparar_id_contando(int id, NoArvoreBST* no) {
+    comparacoes_arvores++;
+    int outro = ocorrencia_do_no_bst(no)->id;
+    return (id > outro) - (id < outro);
+}
+
+//Compara a chave (gravidade, id) com a de um nó da AVL, contando a comparação
+int comparar_prioridade_contando(int gravidade, int id, NoArvoreAVL* no) {
+    comparacoes_arvores++;
+    return comparar_prioridade_avl(gravidade, id, ocorrencia_do_no_avl(no));
+}
+
+//Percorre o caminho que buscar_bst, inserir_bst e remover_bst fazem para o ID
+//(a mesma descida, nó por nó, até achar o ID ou cair em uma folha)
+void contar_caminho_bst(ArvoreBST* arvore, int id) {
+    NoArvoreBST* no = arvore->raiz;
+    while (no) {
+        int comparacao = comparar_id_contando(id, no);
+        if (comparacao == 0) return;
+        no = comparacao < 0 ? no->esquerda : no->direita;
+    }
+}
+
+//Percorre o caminho que as buscas, inserções e remoções da AVL fazem para a chave
+void contar_caminho_avl(ArvoreAVL* arvore, int gravidade, int id) {
+    NoArvoreAVL* no = arvore->raiz;
+    while (no) {
+        int comparacao = comparar_prioridade_contando(gravidade, id, no);
+        if (comparacao == 0) return;
+        no = comparacao < 0 ? no->esquerda : no->direita;
+    }
+}
+
+//Compara dois tempos (para qsort)
+int comparar_tempos(const void* a, const void* b) {
+    double x = *(const double*)a;
+    double y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+
+//Nome de uma estrutura do benchmark
+const char* estrutura_benchmark_string(EstruturaBenchmark estrutura) {
+    switch (estrutura) {
+        case BENCH_SEQUENCIAL: return "Sequencial";
+        case BENCH_BST: return "BST";
+        case BENCH_AVL: return "AVL";
+        default: return "Desconhecida";
+    }
+}
+
+//Nome de uma operação do benchmark
+const char* operacao_benchmark_string(OperacaoBenchmark operacao) {
+    switch (operacao) {
+        case BENCH_BUSCAR: return "buscar";
+        case BENCH_INSERIR: return "inserir";
+        case BENCH_REMOVER: return "remover";
+        default: return "desconhecida";
+    }
+}
+
+//Executa uma operação sobre a estrutura em teste
+//Com contar, soma antes as comparações que a operação vai fazer (a estrutura ainda não mudou)
+void executar_operacao_benchmark(EstruturasBenchmark* estruturas, EstruturaBenchmark estrutura,
+                                 OperacaoBenchmark operacao, Ocorrencia* alvo, int contar) {
+    if (estrutura == BENCH_SEQUENCIAL) {
+        if (operacao == BENCH_INSERIR) {
+            estruturas->lista[estruturas->tamanho_lista++] = alvo;
+            return;
+        }
+        
+        //Busca e remoção varrem a lista até achar o ID
+        long i = 0;
+        while (i < estruturas->tamanho_lista && estruturas->lista[i]->id != alvo->id) {
+            i++;
+        }
+        if (contar) comparacoes_arvores += i < estruturas->tamanho_lista ? i + 1 : i;
+        if (operacao == BENCH_REMOVER && i < estruturas->tamanho_lista) {
+            estruturas->lista[i] = estruturas->lista[--estruturas->tamanho_lista];
+        }
+    } else if (estrutura == BENCH_BST) {
+        if (contar) {
+            contar_caminho_bst(estruturas->bst, alvo->id);
+            //remover_ocorrencia_bst confirma o ID com buscar_bst antes de descer de novo para remover
+            if (operacao == BENCH_REMOVER) contar_caminho_bst(estruturas->bst, alvo->id);
+        }
+        switch (operacao) {
+            case BENCH_BUSCAR: buscar_ocorrencia_por_id(estruturas->bst, alvo->id); break;
+            case BENCH_INSERIR: inserir_bst(estruturas->bst, alvo); break;
+            case BENCH_REMOVER: remover_ocorrencia_bst(estruturas->bst, alvo->id); break;
+        }
+    } else {
+        if (contar) contar_caminho_avl(estruturas->avl, alvo->gravidade, alvo->id);
+        switch (operacao) {
+            case BENCH_BUSCAR: buscar_ocorrencia_avl(estruturas->avl, alvo->gravidade, alvo->id); break;
+            case BENCH_INSERIR: inserir_avl_arvore(estruturas->avl, alvo); break;
+            case BENCH_REMOVER: remover_ocorrencia_avl(estruturas->avl, alvo->gravidade, alvo->id); break;
+        }
+    }
+}
+
+//Roda as operações sobre uma lista de alvos
+//Com contar, só conta as comparações; sem, cronometra lotes de LOTE_BENCHMARK_ARVORES operações
+//(o relógio fica fora do laço de cada operação) e tira os percentis das médias por lote
+void medir_operacoes_benchmark(EstruturasBenchmark* estruturas, EstruturaBenchmark estrutura,
+                               OperacaoBenchmark operacao, Ocorrencia** alvos, long quantidade,
+                               int contar, double* amostras, ResultadoBenchmark* resultado) {
+    resultado->estrutura = estrutura_benchmark_string(estrutura);
+    resultado->operacao = operacao_benchmark_string(operacao);
+    resultado->operacoes = quantidade;
+    
+    if (contar) {
+        long long comparacoes_antes = comparacoes_arvores;
+        for (long i = 0; i < quantidade; i++) {
+            executar_operacao_benchmark(estruturas, estrutura, operacao, alvos[i], 1);
+        }
+        resultado->comparacoes_por_op = (double)(comparacoes_arvores - comparacoes_antes) / quantidade;
+        return;
+    }
+    
+    long lotes = 0;
+    double total = 0;
+    for (long inicio_lote = 0; inicio_lote < quantidade; inicio_lote += LOTE_BENCHMARK_ARVORES) {
+        long fim_lote = inicio_lote + LOTE_BENCHMARK_ARVORES < quantidade ? inicio_lote + LOTE_BENCHMARK_ARVORES : quantidade;
+        
+        double inicio = tempo_em_segundos();
+        for (long i = inicio_lote; i < fim_lote; i++) {
+            executar_operacao_benchmark(estruturas, estrutura, operacao, alvos[i], 0);
+        }
+        double decorrido = tempo_em_segundos() - inicio;
+        
+        total += decorrido;
+        amostras[lotes++] = decorrido * 1e9 / (fim_lote - inicio_lote);
+    }
+    
+    qsort(amostras, lotes, sizeof(double), comparar_tempos);
+    resultado->ns_por_op = total * 1e9 / quantidade;
+    resultado->p50_ns = amostras[(lotes - 1) / 2];
+    resultado->p99_ns = amostras[(long)((lotes - 1) * 0.99)];
+}
+
+//Mostra um resultado na tabela e, se houver arquivo, grava a linha CSV
+//(sem tabela nem arquivo, como no aquecimento, o resultado é descartado)
+void registrar_resultado_benchmark(ResultadoBenchmark* resultado, FILE* tabela, FILE* csv) {
+    if (tabela) {
+        fprintf(tabela, "%-10s | %-7s | %8ld | %7ld | %9.1f | %9.1f | %9.1f | %12.1f\n",
+                resultado->estrutura, resultado->operacao, resultado->n, resultado->operacoes,
+                resultado->ns_por_op, resultado->p50_ns, resultado->p99_ns, resultado->comparacoes_por_op);
+        fflush(tabela);
+    }
+    
+    if (csv) {
+        fprintf(csv, "%s,%s,%ld,%ld,%.1f,%.1f,%.1f,%.1f\n",
+                resultado->estrutura, resultado->operacao, resultado->n, resultado->operacoes,
+                resultado->ns_por_op, resultado->p50_ns, resultado->p99_ns, resultado->comparacoes_por_op);
+    }
+}
+
+//Monta a estrutura com n ocorrências e roda as buscas, inserções e remoções
+//Cada passada recria as mesmas ocorrências e sorteia os mesmos alvos (a semente é reiniciada),
+//então a passada que conta e a que cronometra veem exatamente as mesmas árvores
+int executar_passada_benchmark(EstruturaBenchmark estrutura, long n, long operacoes, int contar,
+                               EstruturasBenchmark* estruturas, Ocorrencia** alvos, double* amostras,
+                               ResultadoBenchmark* resultados) {
+    uint64_t estado = SEMENTE_BENCHMARK_ARVORES;
+    long total = n + operacoes;
+    Ocorrencia** ocorrencias = (Ocorrencia**)malloc(total * sizeof(Ocorrencia*));
+    if (!ocorrencias) {
+        fprintf(stderr, "Memória insuficiente para o benchmark com N = %ld!\n", n);
+        return 0;
+    }
+    
+    //IDs 1..n+m embaralhados (Fisher-Yates): os n primeiros formam a carga inicial
+    //e os seguintes são as inserções
+    for (long i = 0; i < total; i++) {
+        ocorrencias[i] = criar_ocorrencia((int)i + 1, (int)(i % 100), (TipoServico)(i % NUM_TIPOS_SERVICO),
+                                          1 + (int)(proximo_aleatorio_benchmark(&estado) % NIVEIS_GRAVIDADE), 0);
+    }
+    for (long i = total - 1; i > 0; i--) {
+        long j = (long)(proximo_aleatorio_benchmark(&estado) % (uint64_t)(i + 1));
+        Ocorrencia* temp = ocorrencias[i];
+        ocorrencias[i] = ocorrencias[j];
+        ocorrencias[j] = temp;
+    }
+    
+    estruturas->tamanho_lista = 0;
+    estruturas->bst = estrutura == BENCH_BST ? criar_arvore_bst() : NULL;
+    estruturas->avl = estrutura == BENCH_AVL ? criar_arvore_avl() : NULL;
+    for (long i = 0; i < n; i++) {
+        executar_operacao_benchmark(estruturas, estrutura, BENCH_INSERIR, ocorrencias[i], 0);
+    }
+    
+    //Buscas de IDs presentes, sorteados
+    for (long i = 0; i < operacoes; i++) {
+        alvos[i] = ocorrencias[proximo_aleatorio_benchmark(&estado) % (uint64_t)n];
+    }
+    medir_operacoes_benchmark(estruturas, estrutura, BENCH_BUSCAR, alvos, operacoes, contar, amostras, &resultados[BENCH_BUSCAR]);
+    
+    //Inserções dos IDs reservados
+    medir_operacoes_benchmark(estruturas, estrutura, BENCH_INSERIR, ocorrencias + n, operacoes, contar, amostras, &resultados[BENCH_INSERIR]);
+    
+    //Remoções de IDs distintos da carga inicial, sorteados sem repetição (Fisher-Yates parcial)
+    //A estrutura já foi montada, então reordenar o vetor não a afeta
+    long remocoes = operacoes < n ? operacoes : n;
+    for (long i = 0; i < remocoes; i++) {
+        long j = i + (long)(proximo_aleatorio_benchmark(&estado) % (uint64_t)(n - i));
+        Ocorrencia* temp = ocorrencias[i];
+        ocorrencias[i] = ocorrencias[j];
+        ocorrencias[j] = temp;
+    }
+    medir_operacoes_benchmark(estruturas, estrutura, BENCH_REMOVER, ocorrencias, remocoes, contar, amostras, &resultados[BENCH_REMOVER]);
+    
+    if (estrutura == BENCH_BST) {
+        //A BST é dona das ocorrências: liberou as removidas e libera as que sobraram
+        liberar_bst_completa(estruturas->bst);
+    } else {
+        if (estrutura == BENCH_AVL) liberar_avl_completa(estruturas->avl);
+        for (long i = 0; i < total; i++) {
+            liberar_ocorrencia(ocorrencias[i]);
+        }
+    }
+    
+    free(ocorrencias);
+    return 1;
+}
+
+//Compara lista sequencial, BST e AVL com n ocorrências sintéticas e m buscas, inserções e remoções
+//Os IDs seguem uma ordem aleatória: com IDs crescentes, como no sistema, a BST vira uma lista
+//Cada estrutura roda duas vezes: uma conta as comparações e a outra só cronometra
+int executar_benchmark_arvores(long n, long m, FILE* tabela, FILE* csv) {
+    long maximo_lotes = (m + LOTE_BENCHMARK_ARVORES - 1) / LOTE_BENCHMARK_ARVORES;
+    Ocorrencia** alvos = (Ocorrencia**)malloc(m * sizeof(Ocorrencia*));
+    double* amostras = (double*)malloc(maximo_lotes * sizeof(double));
+    EstruturasBenchmark estruturas;
+    estruturas.lista = (Ocorrencia**)malloc((n + m) * sizeof(Ocorrencia*));
+    if (!alvos || !amostras || !estruturas.lista) {
+        fprintf(stderr, "Memória insuficiente para o benchmark com N = %ld!\n", n);
+        free(alvos);
+        free(amostras);
+        free(estruturas.lista);
+        return 0;
+    }
+    
+    int sucesso = 1;
+    EstruturaBenchmark ordem[] = { BENCH_SEQUENCIAL, BENCH_BST, BENCH_AVL };
+    for (int e = 0; e < 3 && sucesso; e++) {
+        EstruturaBenchmark estrutura = ordem[e];
+        
+        //A lista sequencial custa O(n) por operação; limita o total de comparações
+        long operacoes = m;
+        long limite = ORCAMENTO_BENCHMARK_SEQUENCIAL / n > 10 ? ORCAMENTO_BENCHMARK_SEQUENCIAL / n : 10;
+        if (estrutura == BENCH_SEQUENCIAL && operacoes > limite) operacoes = limite;
+        
+        ResultadoBenchmark resultados[3];
+        for (int op = 0; op < 3; op++) {
+            resultados[op].n = n;
+        }
+        
+        sucesso = executar_passada_benchmark(estrutura, n, operacoes, 1, &estruturas, alvos, amostras, resultados) &&
+                  executar_passada_benchmark(estrutura, n, operacoes, 0, &estruturas, alvos, amostras, resultados);
+        if (sucesso) {
+            for (int op = 0; op < 3; op++) {
+                registrar_resultado_benchmark(&resultados[op], tabela, csv);
+            }
+        }
+    }
+    
+    free(alvos);
+    free(amostras);
+    free(estruturas.lista);
+    return sucesso;
+}
+
+//Roda o benchmark para um tamanho n ou, com n = 0, para a série de 10^3 a 10^7, mostrando a tabela em saida
+//Se arquivo_csv não for vazio, grava os resultados nele em CSV
+int benchmark_arvores(long n, long m, const char* arquivo_csv, FILE* saida) {
+    if (m < 1 || (n != 0 && (n < BENCHMARK_TAMANHO_MINIMO || n > BENCHMARK_TAMANHO_MAXIMO))) {
+        fprintf(stderr, "Use N entre %d e %d (ou 0 para a série) e M >= 1!\n",
+                BENCHMARK_TAMANHO_MINIMO, BENCHMARK_TAMANHO_MAXIMO);
+        return 0;
+    }
+    
+    FILE* csv = NULL;
+    if (arquivo_csv && arquivo_csv[0] != '\0') {
+        csv = fopen(arquivo_csv, "w");
+        if (!csv) {
+            fprintf(stderr, "Não foi possível criar o arquivo %s!\n", arquivo_csv);
+            return 0;
+        }
+        fprintf(csv, "estrutura,operacao,n,operacoes,ns_por_op,p50_ns,p99_ns,comparacoes_por_op\n");
+    }
+    
+    //Aquecimento com o menor N (resultados descartados)
+    executar_benchmark_arvores(BENCHMARK_TAMANHO_MINIMO, BENCHMARK_TAMANHO_MINIMO, NULL, NULL);
+    
+    fprintf(saida, "%-10s | %-7s | %8s | %7s | %9s | %9s | %9s | %12s\n",
+            "Estrutura", "Operação", "N", "Ops", "ns/op", "p50 (ns)", "p99 (ns)", "Comparações");
+    fprintf(saida, "----------------------------------------------------------------------------------------\n");
+    
+    int sucesso = 1;
+    if (n != 0) {
+        sucesso = executar_benchmark_arvores(n, m, saida, csv);
+    } else {
+        for (long tamanho = BENCHMARK_TAMANHO_MINIMO; tamanho <= BENCHMARK_TAMANHO_MAXIMO && sucesso; tamanho *= 10) {
+            sucesso = executar_benchmark_arvores(tamanho, m, saida, csv);
+        }
+    }
+    
+    if (csv) {
+        fclose(csv);
+        if (sucesso) fprintf(saida, "Resultados exportados para %s\n", arquivo_csv);
+    }
+    return sucesso;
+}
+
 // ==================== IMPLEMENTAÇÃO - SIMULAÇÃO PRINCIPAL ====================
 
 //Função principal de simulação com dados de exemplo
@@ -2007,16 +5540,16 @@ void iniciar_simulacao(SistemaEmergencia* sistema) {
     printf("--------------------------------------------\n");
     
     printf("Demonstrando busca inteligente por ID:\n");
-    mostrar_arvore_bst(sistema->arvore_ocorrencias);
+    mostrar_estrutura_indice(sistema->indice_ocorrencias);
     
     printf("\nDemonstrando priorização automática:\n");
-    mostrar_arvore_avl(sistema->arvore_prioridades);
+    mostrar_estrutura_prioridades(sistema->prioridades);
     
     //Teste de busca específica
     printf("\nTeste de busca rápida:\n");
-    Ocorrencia* teste = buscar_ocorrencia_por_id(sistema->arvore_ocorrencias, 1);
+    Ocorrencia* teste = buscar_indice_ocorrencia(sistema->indice_ocorrencias, 1);
     if (teste) {
-        printf("Busca por ID 1: SUCESSO em O(log n)!\n");
+        printf("Busca por ID 1: SUCESSO em O(1)!\n");
     }
     
     pausar_sistema();
@@ -2038,8 +5571,8 @@ void iniciar_simulacao(SistemaEmergencia* sistema) {
     //Estatísticas das estruturas avançadas
     printf("\nESTRUTURAS INTELIGENTES:\n");
     printf("--------------------------------------------\n");
-    printf("BST - Ocorrências indexadas: %d\n", sistema->arvore_ocorrencias->tamanho);
-    printf("AVL - Ocorrências priorizadas: %d\n", sistema->arvore_prioridades->tamanho);
+    printf("Índice por ID - Ocorrências indexadas: %d\n", sistema->indice_ocorrencias->tamanho);
+    printf("%s - Ocorrências priorizadas: %d\n", nome_indice_prioridades(), sistema->prioridades->tamanho);
     printf("Eficiência de busca: O(log n) garantida\n");
     printf("Balanceamento: Automático (AVL)\n");
     
@@ -2073,20 +5606,20 @@ void verificar_dados(SistemaEmergencia* sistema) {
     printf("\nESTRUTURAS AVANÇADAS:\n");
     printf("--------------------------------------------\n");
     
-    //Verifica árvore BST
-    if (sistema->arvore_ocorrencias->tamanho > 0) {
-        printf("ÁRVORE BST - Consulta por ID:\n");
-        mostrar_arvore_ordenada_por_id(sistema->arvore_ocorrencias);
+    //Verifica índice por ID
+    if (sistema->indice_ocorrencias->tamanho > 0) {
+        printf("ÍNDICE POR ID - Consulta por ID:\n");
+        mostrar_indice_ocorrencias(sistema->indice_ocorrencias);
     } else {
-        printf("Árvore BST vazia - nenhuma ocorrência cadastrada\n");
+        printf("Índice por ID vazio - nenhuma ocorrência cadastrada\n");
     }
     
     printf("\n");
     
     //Verifica árvore AVL
-    if (sistema->arvore_prioridades->tamanho > 0) {
+    if (sistema->prioridades->tamanho > 0) {
         printf("ÁRVORE AVL - Ordenação por Prioridade:\n");
-        mostrar_ocorrencias_por_prioridade(sistema->arvore_prioridades);
+        mostrar_prioridades(sistema->prioridades);
     } else {
         printf("Árvore AVL vazia - nenhuma ocorrência priorizada\n");
     }
@@ -2101,13 +5634,13 @@ void verificar_dados(SistemaEmergencia* sistema) {
     printf("Complexidades de busca:\n");
     printf("   • Bairros por ID: O(1) - Hash Table\n");
     printf("   • Cidadãos por CPF: O(1) - Hash Table\n");
-    printf("   • Ocorrências por ID: O(log n) - BST\n");
+    printf("   • Ocorrências por ID: O(1) - Índice direto em blocos\n");
     printf("   • Priorização: O(log n) - AVL balanceada\n");
     printf("   • Filas de atendimento: O(1) - FIFO\n");
     printf("   • Histórico: O(1) - Pilhas LIFO\n");
     
     printf("\nRecomendações:\n");
-    if (sistema->arvore_ocorrencias->tamanho == 0) {
+    if (sistema->indice_ocorrencias->tamanho == 0) {
         printf("Execute uma simulação para ver as árvores em ação!\n");
     } else {
         printf("Sistema com dados suficientes para análise\n");
@@ -2124,4 +5657,331 @@ void verificar_dados(SistemaEmergencia* sistema) {
     printf("--------------------------------------------\n");
     
     pausar_sistema();
-}
\ No newline at end of file
+}
+
+// ==================== IMPLEMENTAÇÃO - MODO LOTE (SEM INTERFACE) ====================
+
+//Retorna o tempo de relógio monotônico em segundos
+double tempo_em_segundos() {
+    struct timespec agora;
+    clock_gettime(CLOCK_MONOTONIC, &agora);
+    return (double)agora.tv_sec + (double)agora.tv_nsec / 1e9;
+}
+
+//Remove espaços e quebras de linha do início e do fim de um texto
+char* aparar_texto(char* texto) {
+    while (*texto == ' ' || *texto == '\t') texto++;
+    
+    size_t tamanho = strlen(texto);
+    while (tamanho > 0 && (texto[tamanho - 1] == ' ' || texto[tamanho - 1] == '\t' ||
+                           texto[tamanho - 1] == '\n' || texto[tamanho - 1] == '\r')) {
+        texto[--tamanho] = '\0';
+    }
+    return texto;
+}
+
+//Separa uma linha do roteiro em campos delimitados por ';'
+int separar_campos(char* linha, char* campos[], int max_campos) {
+    int quantidade = 0;
+    char* inicio = linha;
+    
+    while (quantidade < max_campos) {
+        char* separador = strchr(inicio, ';');
+        if (separador) *separador = '\0';
+        campos[quantidade++] = aparar_texto(inicio);
+        if (!separador) break;
+        inicio = separador + 1;
+    }
+    
+    return quantidade;
+}
+
+//Converte um inteiro decimal (com sinal opcional) para int, recusando sobras no texto e valores fora da faixa
+//Retorna 1 se converteu
+int ler_inteiro_texto(const char* texto, int* valor) {
+    if (!texto || !valor) return 0;
+    
+    char* fim;
+    errno = 0;
+    long lido = strtol(texto, &fim, 10);
+    if (fim == texto || *fim != '\0' || errno == ERANGE || lido < INT_MIN || lido > INT_MAX) return 0;
+    
+    *valor = (int)lido;
+    return 1;
+}
+
+//Converte o campo da semente do tráfego (inteiro decimal sem sinal de 64 bits)
+//Retorna 1 se converteu; senão liga *numero_invalido e retorna 0
+int ler_campo_semente(char* campos[], int campo, uint64_t* semente, int* numero_invalido) {
+    const char* texto = campos[campo];
+    char* fim;
+    errno = 0;
+    unsigned long long lido = strtoull(texto, &fim, 10);
+    if (texto[0] == '-' || fim == texto || *fim != '\0' || errno == ERANGE) {
+        *numero_invalido = 1;
+        return 0;
+    }
+    
+    *semente = (uint64_t)lido;
+    return 1;
+}
+
+//Converte os campos de primeiro a ultimo em inteiros (valores[i] recebe o campo i)
+//Retorna 1 se todos são válidos; senão liga *numero_invalido, para o erro ser informado como tal
+int ler_campos_inteiros(char* campos[], int primeiro, int ultimo, int* valores, int* numero_invalido) {
+    for (int i = primeiro; i <= ultimo; i++) {
+        if (!ler_inteiro_texto(campos[i], &valores[i])) {
+            *numero_invalido = 1;
+            return 0;
+        }
+    }
+    return 1;
+}
+
+//Converte o nome ou número (1-3) de um serviço no TipoServico correspondente
+int ler_tipo_servico_texto(const char* texto, TipoServico* tipo) {
+    if (!texto || !tipo) return 0;
+    
+    if (strcmp(texto, "AMBULANCIA") == 0 || strcmp(texto, "1") == 0) {
+        *tipo = AMBULANCIA;
+    } else if (strcmp(texto, "BOMBEIRO") == 0 || strcmp(texto, "2") == 0) {
+        *tipo = BOMBEIRO;
+    } else if (strcmp(texto, "POLICIA") == 0 || strcmp(texto, "3") == 0) {
+        *tipo = POLICIA;
+    } else {
+        return 0;
+    }
+    return 1;
+}
+
+//Retorna a pilha de histórico do tipo de serviço
+PilhaHistorico* historico_do_servico(SistemaEmergencia* sistema, TipoServico tipo) {
+    switch (tipo) {
+        case AMBULANCIA: return sistema->historico_ambulancia;
+        case BOMBEIRO: return sistema->historico_bombeiro;
+        case POLICIA: return sistema->historico_policia;
+        default: return NULL;
+    }
+}
+
+//Retorna 1 para os comandos que só escrevem pelo log; os demais (consultas e relatórios)
+//escrevem direto na saída padrão e precisam esperar o log esvaziar antes
+int comando_lote_so_registra_log(const char* comando) {
+    const char* comandos[] = { "bairro", "cidadao", "unidade", "servico", "ocorrencia", "tempo", "modo",
+                               "processar", "cancelar", "reclassificar", "retencao", "log", "agendar", "trafego" };
+    
+    for (size_t i = 0; i < sizeof(comandos) / sizeof(comandos[0]); i++) {
+        if (strcmp(comando, comandos[i]) == 0) return 1;
+    }
+    return 0;
+}
+
+//Executa um comando do roteiro
+//Retorna 1 se executou um evento, 0 para linhas vazias/comentários, -1 para comando inválido
+//e -2 quando um campo numérico não é um inteiro válido
+int executar_comando_lote(SistemaEmergencia* sistema, char* linha) {
+    char* campos[MAX_CAMPOS_LOTE];
+    int valores[MAX_CAMPOS_LOTE];
+    int numero_invalido = 0;
+    TipoServico tipo;
+    uint64_t semente = SEMENTE_TRAFEGO;
+    int nivel;
+    
+    linha = aparar_texto(linha);
+    if (linha[0] == '\0' || linha[0] == '#') return 0;
+    
+    int n = separar_campos(linha, campos, MAX_CAMPOS_LOTE);
+    const char* comando = campos[0];
+    if (!comando_lote_so_registra_log(comando)) sincronizar_log();
+    
+    if (strcmp(comando, "bairro") == 0 && n >= 3 && ler_campos_inteiros(campos, 1, 1, valores, &numero_invalido)) {
+        cadastrar_bairro_sistema(sistema, valores[1], campos[2]);
+    } else if (strcmp(comando, "cidadao") == 0 && n >= 6 && ler_campos_inteiros(campos, 5, 5, valores, &numero_invalido)) {
+        cadastrar_cidadao_sistema(sistema, campos[1], campos[2], campos[3], campos[4], valores[5]);
+    } else if (strcmp(comando, "unidade") == 0 && n >= 4 && ler_tipo_servico_texto(campos[2], &tipo) &&
+               ler_campos_inteiros(campos, 1, 1, valores, &numero_invalido)) {
+        cadastrar_unidade_sistema(sistema, valores[1], tipo, campos[3]);
+    } else if (strcmp(comando, "servico") == 0 && n >= 3 && ler_tipo_servico_texto(campos[2], &tipo) &&
+               ler_campos_inteiros(campos, 1, 1, valores, &numero_invalido)) {
+        adicionar_servico_bairro(sistema->mapa_cidade, valores[1], tipo);
+    } else if (strcmp(comando, "ocorrencia") == 0 && n >= 4 && ler_tipo_servico_texto(campos[2], &tipo) &&
+               ler_campos_inteiros(campos, 1, 1, valores, &numero_invalido) &&
+               ler_campos_inteiros(campos, 3, 3, valores, &numero_invalido)) {
+        receber_ocorrencia(sistema, valores[1], tipo, valores[3]);
+    } else if (strcmp(comando, "agendar") == 0 && n >= 5 && ler_tipo_servico_texto(campos[3], &tipo) &&
+               ler_campos_inteiros(campos, 1, 2, valores, &numero_invalido) &&
+               ler_campos_inteiros(campos, 4, 4, valores, &numero_invalido)) {
+        if (!agendar_ocorrencia(sistema, valores[1], valores[2], tipo, valores[4])) {
+            LOG_ERRO("Erro ao agendar chamado para o tempo %s!\n", campos[1]);
+        }
+    } else if (strcmp(comando, "trafego") == 0 && n >= 3 && ler_campos_inteiros(campos, 1, 2, valores, &numero_invalido) &&
+               (n < 4 || ler_campo_semente(campos, 3, &semente, &numero_invalido))) {
+        gerar_trafego(sistema, valores[1], valores[2], semente);
+    } else if (strcmp(comando, "tempo") == 0 && (n < 2 || ler_campos_inteiros(campos, 1, 1, valores, &numero_invalido))) {
+        simular_tempo(sistema, n >= 2 ? valores[1] : 1);
+    } else if (strcmp(comando, "modo") == 0 && n >= 2 &&
+               (strcmp(campos[1], "FIFO") == 0 || strcmp(campos[1], "PRIORIDADE") == 0)) {
+        sistema->modo_despacho = strcmp(campos[1], "FIFO") == 0 ? DESPACHO_FIFO : DESPACHO_PRIORIDADE;
+    } else if (strcmp(comando, "processar") == 0) {
+        processar_atendimentos(sistema);
+    } else if (strcmp(comando, "status") == 0) {
+        status_sistema(sistema);
+    } else if (strcmp(comando, "buscar_cidadao") == 0 && n >= 2) {
+        Cidadao* cidadao = buscar_cidadao(sistema->cidadaos, campos[1]);
+        if (cidadao) {
+            char cpf[MAX_CPF];
+            formatar_cpf(cidadao->cpf, cpf);
+            printf("Cidadão %s: %s - Bairro ID: %d\n", cpf, cidadao->nome, cidadao->bairro_id);
+        } else {
+            printf("Cidadão %s não encontrado!\n", campos[1]);
+        }
+    } else if (strcmp(comando, "buscar_bairro") == 0 && n >= 2 && ler_campos_inteiros(campos, 1, 1, valores, &numero_invalido)) {
+        Bairro* bairro = buscar_bairro(sistema->bairros, valores[1]);
+        if (bairro) {
+            printf("Bairro %d: %s\n", bairro->id, bairro->nome);
+        } else {
+            printf("Bairro %s não encontrado!\n", campos[1]);
+        }
+    } else if (strcmp(comando, "buscar_ocorrencia") == 0 && n >= 2 && ler_campos_inteiros(campos, 1, 1, valores, &numero_invalido)) {
+        Ocorrencia* ocorrencia = buscar_indice_ocorrencia(sistema->indice_ocorrencias, valores[1]);
+        if (ocorrencia) {
+            printf("Ocorrência %d: Bairro %d | %s | Gravidade %d | Tempo %d\n",
+                   ocorrencia->id, ocorrencia->bairro_id,
+                   tipo_servico_string(ocorrencia->tipo_servico),
+                   ocorrencia->gravidade, ocorrencia->tempo_chegada);
+        } else if (buscar_arquivo_ocorrencia(sistema->arquivo, valores[1])) {
+            printf("Ocorrência %s (arquivada): ", campos[1]);
+            mostrar_ocorrencia_arquivada(buscar_arquivo_ocorrencia(sistema->arquivo, valores[1]));
+        } else {
+            printf("Ocorrência %s não encontrada!\n", campos[1]);
+        }
+    } else if (strcmp(comando, "faixa_id") == 0 && n >= 3 && ler_campos_inteiros(campos, 1, 2, valores, &numero_invalido)) {
+        mostrar_faixa_bmais(sistema->faixas_por_id, valores[1], valores[2]);
+    } else if (strcmp(comando, "faixa_tempo") == 0 && n >= 3 && ler_campos_inteiros(campos, 1, 2, valores, &numero_invalido)) {
+        mostrar_faixa_bmais(sistema->faixas_por_tempo, valores[1], valores[2]);
+    } else if (strcmp(comando, "cancelar") == 0 && n >= 2 && ler_campos_inteiros(campos, 1, 1, valores, &numero_invalido)) {
+        int resultado = cancelar_ocorrencia(sistema, valores[1]);
+        if (resultado > 0) {
+            LOG_INFO("Ocorrência %s cancelada\n", campos[1]);
+        } else if (resultado < 0) {
+            LOG_AVISO("Ocorrência %s já foi despachada e não pode ser cancelada!\n", campos[1]);
+        } else {
+            LOG_AVISO("Ocorrência %s não encontrada!\n", campos[1]);
+        }
+    } else if (strcmp(comando, "reclassificar") == 0 && n >= 3 &&
+               ler_campos_inteiros(campos, 1, (n - 1) / 2 * 2, valores, &numero_invalido)) {
+        //Vários pares id;gravidade na mesma linha viram uma única leva de reclassificações
+        int ids[MAX_CAMPOS_LOTE / 2];
+        int gravidades[MAX_CAMPOS_LOTE / 2];
+        int pares = (n - 1) / 2;
+        for (int i = 0; i < pares; i++) {
+            ids[i] = valores[1 + 2 * i];
+            gravidades[i] = valores[2 + 2 * i];
+        }
+        int aplicadas = reclassificar_lote(sistema, ids, gravidades, pares);
+        LOG_INFO("Reclassificadas %d de %d ocorrências\n", aplicadas, pares);
+    } else if (strcmp(comando, "log") == 0 && n >= 2 && ler_nivel_log_texto(campos[1], &nivel)) {
+        definir_nivel_log(nivel);
+    } else if (strcmp(comando, "latencias") == 0) {
+        mostrar_latencias_servicos(sistema->latencias);
+        mostrar_latencias_bairros(sistema->latencias, sistema->mapa_cidade);
+    } else if (strcmp(comando, "exportar_latencias") == 0 && n >= 2) {
+        exportar_latencias(sistema->latencias, sistema->mapa_cidade, campos[1]);
+    } else if (strcmp(comando, "retencao") == 0 && n >= 3 && ler_campos_inteiros(campos, 1, 2, valores, &numero_invalido)) {
+        configurar_retencao(sistema, valores[1], valores[2]);
+    } else if (strcmp(comando, "arquivo") == 0) {
+        mostrar_resumo_arquivo(sistema->arquivo);
+    } else if (strcmp(comando, "faixa_arquivo") == 0 && n >= 3 && ler_campos_inteiros(campos, 1, 2, valores, &numero_invalido)) {
+        mostrar_faixa_arquivo(sistema->arquivo, valores[1], valores[2]);
+    } else if (strcmp(comando, "posicao_prioridade") == 0 && n >= 2 && ler_campos_inteiros(campos, 1, 1, valores, &numero_invalido)) {
+        Ocorrencia* ocorrencia = buscar_indice_ocorrencia(sistema->indice_ocorrencias, valores[1]);
+        int posicao = posicao_prioridade(sistema->prioridades, ocorrencia);
+        printf("Posição da ocorrência %s na prioridade: %d de %d\n",
+               campos[1], posicao, sistema->prioridades->tamanho);
+    } else if (strcmp(comando, "k_esima") == 0 && n >= 2 && ler_campos_inteiros(campos, 1, 1, valores, &numero_invalido)) {
+        Ocorrencia* ocorrencia = k_esima_prioridade(sistema->prioridades, valores[1]);
+        if (ocorrencia) {
+            mostrar_ocorrencia(ocorrencia);
+        } else {
+            printf("Não há %s ocorrências pendentes!\n", campos[1]);
+        }
+    } else if (strcmp(comando, "contar_gravidade") == 0 && n >= 3 && ler_campos_inteiros(campos, 1, 2, valores, &numero_invalido)) {
+        printf("Pendentes com gravidade %s..%s: %d\n", campos[1], campos[2],
+               contar_prioridades_gravidade(sistema->prioridades, valores[1], valores[2]));
+    } else if (strcmp(comando, "historico") == 0 && n >= 2 && ler_tipo_servico_texto(campos[1], &tipo)) {
+        mostrar_historico(historico_do_servico(sistema, tipo));
+    } else if (strcmp(comando, "mapa") == 0) {
+        mostrar_mapa_cidade(sistema->mapa_cidade);
+    } else if (strcmp(comando, "prioridades") == 0) {
+        mostrar_prioridades(sistema->prioridades);
+    } else {
+        return numero_invalido ? -2 : -1;
+    }
+    
+    return 1;
+}
+
+//Verifica se o fgets leu a linha inteira: o buffer cheio sem '\n' só vale se o arquivo acaba ali
+//ou se o '\n' é o próximo caractere. Senão, descarta o resto da linha e retorna 0, para que a
+//sobra não seja executada como se fosse outro comando
+int linha_lote_completa(char* linha, FILE* entrada) {
+    size_t tamanho = strlen(linha);
+    if (tamanho < MAX_LINHA_LOTE - 1 || linha[tamanho - 1] == '\n') return 1;
+    
+    int caractere = getc(entrada);
+    if (caractere == EOF || caractere == '\n') return 1;
+    
+    while (caractere != EOF && caractere != '\n') {
+        caractere = getc(entrada);
+    }
+    return 0;
+}
+
+//Executa um roteiro de comandos do início ao fim, sem pausas nem menus
+//Ao final, informa a vazão medida em eventos por segundo
+long executar_lote(SistemaEmergencia* sistema, FILE* entrada) {
+    if (!sistema || !entrada) return 0;
+    
+    char linha[MAX_LINHA_LOTE];
+    long eventos = 0;
+    long erros = 0;
+    long numero_linha = 0;
+    
+    //Sem menus para intercalar, as mensagens do log saem pela thread escritora
+    iniciar_log_assincrono();
+    double inicio = tempo_em_segundos();
+    
+    while (fgets(linha, sizeof(linha), entrada)) {
+        numero_linha++;
+        if (!linha_lote_completa(linha, entrada)) {
+            erros++;
+            fprintf(stderr, "Linha %ld: maior que %d caracteres, ignorada\n", numero_linha, MAX_LINHA_LOTE - 1);
+            continue;
+        }
+        
+        int resultado = executar_comando_lote(sistema, linha);
+        if (resultado > 0) {
+            eventos++;
+        } else if (resultado == -2) {
+            erros++;
+            fprintf(stderr, "Linha %ld: número inválido ou fora da faixa\n", numero_linha);
+        } else if (resultado < 0) {
+            erros++;
+            fprintf(stderr, "Linha %ld: comando inválido\n", numero_linha);
+        }
+    }
+    
+    //A vazão conta o tempo de escrever o log inteiro
+    sincronizar_log();
+    double decorrido = tempo_em_segundos() - inicio;
+    encerrar_log();
+    
+    printf("\n=== RESUMO DO MODO LOTE ===\n");
+    printf("Linhas lidas: %ld\n", numero_linha);
+    printf("Eventos executados: %ld\n", eventos);
+    printf("Comandos inválidos: %ld\n", erros);
+    printf("Tempo de relógio: %.6f s\n", decorrido);
+    printf("Vazão: %.1f eventos/s\n", decorrido > 0 ? eventos / decorrido : 0.0);
+    
+    return eventos;
+}
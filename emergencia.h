@@ -3,15 +3,88 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <stddef.h>
 #include <string.h>
+#include <stdint.h>
+#include <stdarg.h>
 #include <time.h>
+#include <pthread.h>
 
 // ==================== CONSTANTES ====================
-#define TAM_HASH 101 //Tamanho da tabela Hash
+#define TAM_HASH_INICIAL 8 //Tamanho inicial das tabelas hash (potência de 2, cresce com a carga)
+#define BALDES_MIGRADOS_POR_OPERACAO 4 //Baldes migrados por operação durante o rehash incremental
 #define MAX_NOME 100 //Tamanho máximo para nomes
 #define MAX_ENDERECO 200 //Tamanho máximo para endereços
-#define MAX_CPF 15 //Tamanho máximo para CPF
+#define MAX_CPF 15 //Tamanho máximo para CPF formatado (XXX.XXX.XXX-XX)
+#define DIGITOS_CPF 11 //Quantidade de dígitos de um CPF
 #define MAX_EMAIL 100 //Tamanho máximo para email
+#define FILA_CAPACIDADE_INICIAL 16 //Capacidade inicial das filas circulares (potência de 2)
+#define HEAP_CAPACIDADE_INICIAL 16 //Capacidade inicial do calendário de eventos da simulação
+#define ARQUIVO_CAPACIDADE_INICIAL 64 //Capacidade inicial do arquivo e da fila de concluídas (potência de 2)
+#define RETENCAO_DESLIGADA -1 //Limite de retenção desligado (idade ou quantidade sem limite)
+#define DURACAO_AMBULANCIA 2 //Unidades de tempo de um atendimento de ambulância
+#define DURACAO_BOMBEIRO 3 //Unidades de tempo de um atendimento de bombeiro
+#define DURACAO_POLICIA 1 //Unidades de tempo de um atendimento policial
+#define DESLOCAMENTO_AMBULANCIA 1 //Parte do atendimento de ambulância gasta até chegar ao local
+#define DESLOCAMENTO_BOMBEIRO 1 //Parte do atendimento de bombeiro gasta até chegar ao local
+#define DESLOCAMENTO_POLICIA 0 //Parte do atendimento policial gasta até chegar ao local
+#define ATRASO_DESPACHO 1 //Unidades de tempo entre a chegada de um chamado e seu primeiro despacho possível
+#define TEMPO_RETORNO 0 //Unidades de tempo entre o fim do atendimento e a unidade voltar a ficar livre
+#define SEMENTE_TRAFEGO 88172645463325252ULL //Semente usada pelo gerador de tráfego quando nenhuma é informada
+#define OBJETOS_POR_BLOCO 256 //Objetos alocados de uma vez em cada bloco dos pools de memória
+#define OCORRENCIAS_POR_BLOCO_INDICE 1024 //Posições de cada bloco do índice de ocorrências (potência de 2)
+#define ORDEM_ARVORE_BMAIS 32 //Máximo de chaves por nó das árvores B+ (mínimo de metade fora da raiz)
+#define UNIDADES_CAPACIDADE_INICIAL 64 //Unidades iniciais do registro da frota (múltiplo de 64, uma palavra por bitset)
+#define MAPA_CAPACIDADE_INICIAL 16 //Bairros iniciais na matriz do mapa da cidade (múltiplo de SOMA_COLUNA_LARGURA)
+#define SOMA_COLUNA_LARGURA 8 //Parcelas somadas lado a lado ao totalizar uma coluna do mapa (vetorizável)
+#ifndef NIVEIS_GRAVIDADE
+#define NIVEIS_GRAVIDADE 3 //Níveis de gravidade (1 a NIVEIS_GRAVIDADE), um balde por nível na fila de baldes
+#endif
+#define MAX_LINHA_LOTE 1024 //Tamanho máximo de uma linha do roteiro em lote
+#define MAX_CAMPOS_LOTE 129 //Número máximo de campos por comando do roteiro (comando + 64 pares id;gravidade)
+#define BENCHMARK_TAMANHO_MINIMO 1000 //Menor N do benchmark das árvores
+#define BENCHMARK_TAMANHO_MAXIMO 10000000 //Maior N do benchmark das árvores
+#define ORCAMENTO_BENCHMARK_SEQUENCIAL 100000000L //Comparações por tipo de operação na lista sequencial
+#define LOTE_BENCHMARK_ARVORES 64 //Operações cronometradas juntas no benchmark das árvores
+#define SEMENTE_BENCHMARK_ARVORES 88172645463325252ULL //Semente do benchmark das árvores, reiniciada a cada passada
+#define BENCHMARK_N_MENU 10000 //N padrão do benchmark das árvores pelo menu
+#define BENCHMARK_M_MENU 10000 //M padrão do benchmark das árvores pelo menu
+#define BITS_EXATOS_HISTOGRAMA 5 //Valores de 0 a 31 têm balde próprio nos histogramas de latência
+#define BITS_SUBBALDES_HISTOGRAMA 4 //Cada potência de 2 acima é dividida em 16 baldes (erro de até 1/16)
+//Baldes exatos mais 2^BITS_SUBBALDES_HISTOGRAMA por potência de 2 de 2^BITS_EXATOS_HISTOGRAMA a 2^30 (448 com 5 e 4)
+#define BALDES_HISTOGRAMA ((1 << BITS_EXATOS_HISTOGRAMA) + ((31 - BITS_EXATOS_HISTOGRAMA) << BITS_SUBBALDES_HISTOGRAMA))
+#define CAPACIDADE_LOG 4096 //Mensagens no anel do log assíncrono (potência de 2)
+#define TAMANHO_MENSAGEM_LOG 256 //Tamanho máximo de uma mensagem do log (o excesso é cortado)
+#define ESPERA_ESCRITORA_LOG_NS 200000L //Pausa da thread escritora quando o anel está vazio
+
+//Níveis do log: uma mensagem sai se o seu nível for no máximo o nível atual
+#define NIVEL_LOG_SILENCIOSO -1
+#define NIVEL_LOG_ERRO 0
+#define NIVEL_LOG_AVISO 1
+#define NIVEL_LOG_INFO 2
+#define NIVEL_LOG_DEPURACAO 3
+
+//Níveis acima deste somem na compilação (ex.: -DNIVEL_LOG_COMPILADO=NIVEL_LOG_ERRO)
+#ifndef NIVEL_LOG_COMPILADO
+#define NIVEL_LOG_COMPILADO NIVEL_LOG_DEPURACAO
+#endif
+
+// ==================== STRUCTS POOLS DE MEMÓRIA ====================
+//Pool de objetos de tamanho fixo: aloca blocos com vários objetos e reaproveita
+//os liberados por uma lista livre, evitando um malloc/free por objeto
+//Só ocorrências e nós das árvores B+ usam pools. A fila não tem nós: o buffer circular
+//reaproveita as próprias posições, e é ele que faz o papel de pool dos itens enfileirados
+typedef struct BlocoPool {
+    struct BlocoPool* prox; //Os objetos do bloco ficam logo após este cabeçalho
+} BlocoPool;
+
+typedef struct {
+    size_t tamanho_objeto;
+    int objetos_por_bloco;
+    void* livres; //Lista livre (o próprio objeto guarda o ponteiro para o próximo)
+    BlocoPool* blocos;
+    int em_uso;
+} PoolMemoria;
 
 // ==================== STRUCTS BAIRROS ====================
 typedef struct Bairro {
@@ -21,22 +94,58 @@ typedef struct Bairro {
 } Bairro;
 
 typedef struct {
-    Bairro* tabela[TAM_HASH];
+    Bairro** tabela; //Baldes atuais
+    int capacidade;
+    Bairro** tabela_antiga; //Baldes ainda não migrados durante o rehash (NULL fora dele)
+    int capacidade_antiga;
+    int indice_migracao; //Próximo balde da tabela antiga a ser migrado
+    int quantidade;
 } TabelaHashBairros;
 
 // ==================== STRUCTS CIDADÃOS ====================
+//Compile com -DCIDADAOS_TABELA_PLANA para usar a tabela de endereçamento aberto
+//no lugar da tabela encadeada (a interface das funções é a mesma)
 typedef struct Cidadao {
-    char cpf[MAX_CPF];
+    uint64_t cpf; //CPF normalizado como inteiro de 11 dígitos
     char nome[MAX_NOME];
     char email[MAX_EMAIL];
     char endereco[MAX_ENDERECO];
     int bairro_id;
+#ifndef CIDADAOS_TABELA_PLANA
     struct Cidadao* prox; //Para tratamento de colisões
+#endif
 } Cidadao;
 
+#ifdef CIDADAOS_TABELA_PLANA
+#define ENTRADA_CIDADAO_VAZIA -1 //Entrada livre do índice plano
+#define ENTRADA_CIDADAO_REMOVIDA -2 //Lápide no índice antigo durante a migração (mantém a sondagem)
+
+typedef struct {
+    uint64_t cpf;
+    int registro; //Posição no vetor de registros, ou ENTRADA_CIDADAO_VAZIA/ENTRADA_CIDADAO_REMOVIDA
+    int distancia; //Distância até a posição ideal (Robin Hood)
+} EntradaIndiceCidadao;
+
+typedef struct {
+    EntradaIndiceCidadao* indice; //Endereçamento aberto com sondagem linear
+    int capacidade;
+    EntradaIndiceCidadao* indice_antigo; //Índice anterior ainda não migrado durante o rehash (NULL fora dele)
+    int capacidade_antiga;
+    int indice_migracao; //Próxima entrada do índice antigo a ser migrada
+    Cidadao* registros; //Registros contíguos, sem buracos
+    int capacidade_registros;
+    int quantidade;
+} TabelaHashCidadaos;
+#else
 typedef struct {
-    Cidadao* tabela[TAM_HASH];
+    Cidadao** tabela; //Baldes atuais
+    int capacidade;
+    Cidadao** tabela_antiga; //Baldes ainda não migrados durante o rehash (NULL fora dele)
+    int capacidade_antiga;
+    int indice_migracao; //Próximo balde da tabela antiga a ser migrado
+    int quantidade;
 } TabelaHashCidadaos;
+#endif
 
 // ==================== STRUCTS UNIDADES DE SERVIÇO ====================
 typedef enum {
@@ -45,13 +154,55 @@ typedef enum {
     POLICIA
 } TipoServico;
 
-typedef struct UnidadeServico {
-    int id;
-    TipoServico tipo;
-    char identificacao[MAX_NOME];
-    int disponivel; //Booleano, 1 é disponível e 0 é ocupado
-    struct UnidadeServico* prox;
-} UnidadeServico;
+#define NUM_TIPOS_SERVICO 3 //Quantidade de valores de TipoServico
+
+//Registro de unidades em estrutura de vetores (SoA): a unidade é a sua posição nos vetores
+//Os dados quentes (ID e tipo) ficam em vetores densos e a disponibilidade em um bitset por
+//tipo (bit i ligado = unidade i livre), então achar uma unidade livre varre palavras de 64 bits
+typedef struct {
+    int* ids; //ID de cada unidade, na ordem de cadastro
+    unsigned char* tipos; //TipoServico de cada unidade
+    char (*identificacoes)[MAX_NOME]; //Texto usado só nas mensagens
+    int* bairros_mapa; //Bairro do mapa da cidade em que cada unidade ocupada foi descontada (-1 se nenhum)
+    uint64_t* livres[NUM_TIPOS_SERVICO]; //Bitset das unidades livres de cada tipo
+    int primeira_palavra[NUM_TIPOS_SERVICO]; //Palavras anteriores do bitset estão zeradas
+    int livres_por_tipo[NUM_TIPOS_SERVICO]; //Bits ligados de cada bitset, para contar em O(1)
+    int unidades_por_tipo[NUM_TIPOS_SERVICO];
+    int quantidade;
+    int capacidade; //Múltiplo de 64; os bits além da quantidade ficam desligados
+} RegistroUnidades;
+
+//Tipos de evento da simulação, na ordem em que os eventos de um mesmo tempo são tratados
+typedef enum {
+    EVENTO_CONCLUSAO, //Fim do atendimento no local
+    EVENTO_UNIDADE_LIVRE, //Unidade volta a ficar disponível
+    EVENTO_NO_LOCAL, //Unidade chega ao local da ocorrência
+    EVENTO_DESPACHO, //Despacha as pendentes de um serviço enquanto houver unidade livre
+    EVENTO_CHEGADA //Chamado agendado entra no sistema (depois dos despachos do mesmo tempo)
+} TipoEvento;
+
+//Evento do calendário; cada tipo usa só alguns dos campos
+typedef struct {
+    int tempo;
+    TipoEvento tipo;
+    unsigned long long sequencia; //Ordem de agendamento, desempata eventos de mesmo tempo e tipo
+    int ocorrencia_id; //Ocorrência atendida (chegada ao local e conclusão)
+    int unidade; //Posição da unidade no registro (chegada ao local, conclusão e unidade livre)
+    int bairro_id; //Bairro do atendimento ou do chamado agendado
+    TipoServico servico; //Serviço do despacho ou do chamado agendado
+    int gravidade; //Gravidade do chamado agendado
+    int tempo_inicio; //Despacho do atendimento (chegada ao local e conclusão)
+} EventoSimulacao;
+
+//Calendário global de eventos: heap mínimo por (tempo, tipo, sequencia)
+typedef struct {
+    EventoSimulacao* itens;
+    int tamanho;
+    int capacidade;
+    unsigned long long proxima_sequencia;
+    long long processados; //Eventos já tratados pela simulação
+    int despacho_agendado[NUM_TIPOS_SERVICO][ATRASO_DESPACHO + 1]; //Tempos dos despachos pendentes de cada serviço, na posição tempo % (ATRASO_DESPACHO + 1) (-1 se vaga)
+} CalendarioEventos;
 
 // ==================== STRUCTS HISTÓRICO ====================
 typedef struct HistoricoAtendimento {
@@ -71,76 +222,330 @@ typedef struct {
 } PilhaHistorico;
 
 // ==================== STRUCTS OCORRÊNCIAS ====================
+typedef enum {
+    OCORRENCIA_PENDENTE, //Aguardando na fila e na árvore de prioridades
+    OCORRENCIA_EM_ATENDIMENTO, //Já despachada para uma unidade
+    OCORRENCIA_CONCLUIDA //Atendimento encerrado e unidade liberada
+} EstadoOcorrencia;
+
+//Ganchos das árvores embutidos na ocorrência (árvores intrusivas): inserir não aloca
+//nada e a ocorrência de um nó é obtida pelo deslocamento do campo (container-of)
+//Cada ocorrência pode estar em no máximo uma BST e uma AVL ao mesmo tempo
+typedef struct NoArvoreBST {
+    struct NoArvoreBST* esquerda;
+    struct NoArvoreBST* direita;
+} NoArvoreBST;
+
+typedef struct NoArvoreAVL {
+    int altura;
+    int fator_balanceamento;
+    int contagem_servico[NUM_TIPOS_SERVICO]; //Ocorrências de cada serviço nesta subárvore
+    int tamanho_subarvore; //Nós desta subárvore, para consultas de posição (rank/select)
+    struct NoArvoreAVL* esquerda;
+    struct NoArvoreAVL* direita;
+} NoArvoreAVL;
+
 typedef struct Ocorrencia {
     int id;
     int bairro_id;
     TipoServico tipo_servico;
-    int gravidade; //1 para baixa, 2 para média, 3 para alta
+    int gravidade; //1 (baixa) a NIVEIS_GRAVIDADE (alta); sempre dentro da faixa, os dois índices de prioridade dependem disso
     int tempo_chegada; //Unidade de tempo
-    struct Ocorrencia* prox;
+    int tempo_fim; //Fim do atendimento (-1 enquanto não é despachada)
+    EstadoOcorrencia estado;
+    uint32_t geracao; //Muda cada vez que a memória volta ao pool; invalida os handles antigos
+    struct Ocorrencia* prox; //Próxima no balde de prioridade (fila de baldes)
+    struct Ocorrencia* ant; //Anterior no balde de prioridade, para remoção em O(1)
+    NoArvoreBST no_bst; //Gancho da árvore BST (ordenada por ID)
+    NoArvoreAVL no_avl; //Gancho da árvore AVL de prioridades
 } Ocorrencia;
 
-// ==================== STRUCTS FILAS ====================
-typedef struct NoFila {
+//Referência estável a uma ocorrência do índice por ID (o dono)
+//Deixa de valer quando a ocorrência é liberada, mesmo que o pool reaproveite a memória
+typedef struct {
     Ocorrencia* ocorrencia;
-    struct NoFila* prox;
-} NoFila;
+    uint32_t geracao;
+} HandleOcorrencia;
 
+// ==================== STRUCTS ÍNDICE DE OCORRÊNCIAS ====================
+//Vetor endereçado diretamente pelo ID (posição = id - id_base), dividido em blocos
+//de tamanho fixo. Os IDs são sequenciais, então a busca e a inserção são O(1) e
+//a varredura em ordem de ID é um percurso linear pelos blocos
 typedef struct {
-    NoFila* inicio;
-    NoFila* fim;
+    Ocorrencia*** blocos; //Cada bloco tem OCORRENCIAS_POR_BLOCO_INDICE posições; NULL se vazio
+    int* vivos; //Ocorrências presentes em cada bloco
+    int quantidade_blocos;
+    int capacidade_blocos;
+    int id_base; //ID correspondente à primeira posição do bloco 0
     int tamanho;
+} IndiceOcorrencias;
+
+// ==================== STRUCTS ARQUIVO DE OCORRÊNCIAS ====================
+//Registro compacto de uma ocorrência concluída que saiu dos índices vivos
+typedef struct {
+    int id;
+    int bairro_id;
+    int tempo_chegada;
+    int tempo_fim;
+    unsigned char tipo_servico;
+    unsigned char gravidade;
+} OcorrenciaArquivada;
+
+//Arquivo só de acréscimo das ocorrências concluídas, mais a política de retenção
+//As concluídas saem dos índices na ordem em que terminaram, então os registros ficam
+//ordenados por tempo_fim e a consulta por período é uma busca binária
+typedef struct {
+    OcorrenciaArquivada* registros;
+    int quantidade;
+    int capacidade;
+    int* posicoes; //posicoes[id] = posição do registro do ID, ou -1 se não foi arquivado
+    int capacidade_posicoes;
+    HandleOcorrencia* concluidas; //Fila circular das concluídas ainda nos índices, em ordem de conclusão
+    int inicio_concluidas;
+    int ocupadas_concluidas; //Posições usadas, incluindo handles de ocorrências já removidas
+    int capacidade_concluidas; //Sempre potência de 2
+    int concluidas_vivas; //Concluídas ainda nos índices vivos
+    int idade_maxima; //Arquiva as concluídas há pelo menos esse tempo (RETENCAO_DESLIGADA = sem limite)
+    int maximo_concluidas; //Máximo de concluídas nos índices vivos (RETENCAO_DESLIGADA = sem limite)
+} ArquivoOcorrencias;
+
+// ==================== STRUCTS HISTOGRAMAS DE LATÊNCIA ====================
+//Histograma com baldes logarítmicos (no estilo HDR): valores até 2^BITS_EXATOS_HISTOGRAMA - 1
+//têm balde próprio, e cada potência de 2 acima disso é dividida em 2^BITS_SUBBALDES_HISTOGRAMA
+//baldes, o que limita o erro relativo de um percentil a 1/2^BITS_SUBBALDES_HISTOGRAMA
+typedef struct {
+    int contagens[BALDES_HISTOGRAMA];
+    long long total;
+    long long soma;
+    int maximo;
+} HistogramaLatencia;
+
+typedef struct {
+    HistogramaLatencia espera; //Despacho menos chegada, contada no despacho
+    HistogramaLatencia servico; //Conclusão menos despacho, contada quando o atendimento termina
+} LatenciasAtendimento;
+
+typedef struct {
+    LatenciasAtendimento por_servico[NUM_TIPOS_SERVICO];
+    LatenciasAtendimento* por_bairro; //Indexado pelo slot do bairro no mapa da cidade
+    int capacidade_bairros;
+} PainelLatencias;
+
+// ==================== STRUCTS FILAS ====================
+//Fila circular em vetor contíguo; dobra de tamanho quando enche
+typedef struct {
+    HandleOcorrencia* itens; //Handles, pois uma lápide pode sobreviver à ocorrência
+    int capacidade; //Sempre potência de 2
+    int inicio; //Posição da primeira ocorrência
+    int ocupados; //Posições usadas, incluindo lápides de ocorrências que saíram fora de ordem (até 2x tamanho)
+    int tamanho; //Ocorrências pendentes
 } Fila;
 
 // ==================== STRUCTS LISTAS CRUZADAS ====================
+//Os nós formam a visão cruzada (bairro -> serviços oferecidos); os contadores de
+//unidades disponíveis ficam na matriz densa da ListaCruzada
 typedef struct NoServico {
     TipoServico tipo;
-    int unidades_disponiveis;
     struct NoServico* prox_servico;
 } NoServico;
 
 typedef struct NoBairroServico {
     int bairro_id;
+    int slot; //Linha do bairro na matriz de disponibilidade
     char nome_bairro[MAX_NOME];
     NoServico* servicos;
     struct NoBairroServico* prox_bairro;
 } NoBairroServico;
 
+typedef struct {
+    int bairro_id;
+    int slot; //Linha do bairro na matriz; -1 indica entrada vazia
+} EntradaSlotBairro;
+
 typedef struct {
     NoBairroServico* primeiro;
+    EntradaSlotBairro* indice; //ID do bairro -> slot (endereçamento aberto com sondagem linear)
+    int capacidade_indice;
+    int* disponiveis[NUM_TIPOS_SERVICO]; //Matriz densa: uma coluna contígua por serviço, indexada pelo slot
+    unsigned char* servicos_oferecidos; //Máscara (1 << tipo) dos serviços oferecidos em cada slot
+    NoBairroServico** bairros; //Nó da visão cruzada de cada slot
+    int quantidade; //Slots ocupados
+    int capacidade; //Slots alocados (múltiplo de SOMA_COLUNA_LARGURA)
 } ListaCruzada;
 
 // ==================== STRUCTS ÁRVORE BST ====================
-typedef struct NoArvoreBST {
-    Ocorrencia* ocorrencia;
-    struct NoArvoreBST* esquerda;
-    struct NoArvoreBST* direita;
-} NoArvoreBST;
-
+//Os nós (NoArvoreBST) ficam dentro da própria ocorrência; veja STRUCTS OCORRÊNCIAS
 typedef struct {
     NoArvoreBST* raiz;
     int tamanho;
 } ArvoreBST;
 
 // ==================== STRUCTS ÁRVORE AVL ====================
-typedef struct NoArvoreAVL {
-    Ocorrencia* ocorrencia;
-    int altura;
-    int fator_balanceamento;
-    struct NoArvoreAVL* esquerda;
-    struct NoArvoreAVL* direita;
-} NoArvoreAVL;
-
+//Os nós (NoArvoreAVL) ficam dentro da própria ocorrência; veja STRUCTS OCORRÊNCIAS
 typedef struct {
     NoArvoreAVL* raiz;
     int tamanho;
 } ArvoreAVL;
 
+// ==================== STRUCTS ÁRVORE B+ ====================
+typedef enum {
+    BMAIS_POR_ID, //Chave = ID da ocorrência
+    BMAIS_POR_TEMPO //Chave = (tempo de chegada, ID), única mesmo com chegadas simultâneas
+} CriterioBMais;
+
+//Nó de alta ramificação; as folhas guardam as ocorrências e são encadeadas
+//em ordem de chave, então uma consulta por faixa lê folhas contíguas
+//Os vetores têm uma posição a mais para o nó transbordar antes de dividir
+typedef struct NoArvoreBMais {
+    int folha;
+    int quantidade; //Chaves ocupadas
+    uint64_t chaves[ORDEM_ARVORE_BMAIS + 1];
+    union {
+        struct NoArvoreBMais* filhos[ORDEM_ARVORE_BMAIS + 2]; //Nós internos: quantidade + 1 filhos
+        Ocorrencia* ocorrencias[ORDEM_ARVORE_BMAIS + 1]; //Folhas: uma ocorrência por chave
+    } ponteiros;
+    struct NoArvoreBMais* prox; //Próxima folha
+} NoArvoreBMais;
+
+typedef struct {
+    NoArvoreBMais* raiz;
+    CriterioBMais criterio;
+    int tamanho;
+    int altura;
+} ArvoreBMais;
+
+//Posição de uma varredura por faixa [chave atual, fim]
+typedef struct {
+    NoArvoreBMais* folha;
+    int posicao;
+    uint64_t fim;
+} IteradorBMais;
+
+// ==================== STRUCTS FILA DE PRIORIDADE EM BALDES ====================
+//Lista duplamente encadeada pelos campos prox/ant das próprias ocorrências, em ordem de ID
+//Uma reclassificada mais antiga que a última da lista não entra nela: vai para uma árvore
+//AVL do balde (pelo nó AVL embutido, que a fila de baldes não usa para mais nada)
+typedef struct {
+    Ocorrencia* primeira;
+    Ocorrencia* ultima;
+    ArvoreAVL fora_de_ordem; //Reclassificadas mais antigas que a última da lista, ordenadas por ID
+    int tamanho; //Lista e árvore juntas
+} BaldeGravidade;
+
+//Um balde FIFO por serviço e gravidade; como a gravidade só tem NIVEIS_GRAVIDADE
+//valores, chegadas, remoções e a extração da maior são O(1) enquanto não há reclassificadas
+//fora de ordem; com elas, essas operações e a própria reclassificação custam O(log n)
+typedef struct {
+    BaldeGravidade baldes[NUM_TIPOS_SERVICO][NIVEIS_GRAVIDADE];
+    int tamanho;
+} FilaBaldes;
+
+//Percorre um balde em ordem de ID, intercalando a lista com a árvore das reclassificadas
+typedef struct {
+    Ocorrencia* lista; //Próxima da lista
+    Ocorrencia* reclassificada; //Próxima da árvore
+    int posicao; //Posição (rank) de reclassificada na árvore
+    ArvoreAVL* arvore;
+} CursorBalde;
+
+//Índice de prioridades usado pelo sistema
+//Compile com -DPRIORIDADES_BALDES para usar a fila de baldes no lugar da árvore AVL
+#ifdef PRIORIDADES_BALDES
+typedef FilaBaldes IndicePrioridades;
+#else
+typedef ArvoreAVL IndicePrioridades;
+#endif
+
+// ==================== STRUCTS BENCHMARK DAS ÁRVORES ====================
+typedef enum {
+    BENCH_SEQUENCIAL,
+    BENCH_BST,
+    BENCH_AVL
+} EstruturaBenchmark;
+
+typedef enum {
+    BENCH_BUSCAR,
+    BENCH_INSERIR,
+    BENCH_REMOVER
+} OperacaoBenchmark;
+
+typedef struct {
+    Ocorrencia** lista; //Lista sequencial (vetor sem ordem)
+    long tamanho_lista;
+    ArvoreBST* bst;
+    ArvoreAVL* avl;
+} EstruturasBenchmark;
+
+typedef struct {
+    const char* estrutura;
+    const char* operacao;
+    long n;
+    long operacoes;
+    double ns_por_op;
+    double p50_ns;
+    double p99_ns;
+    double comparacoes_por_op;
+} ResultadoBenchmark;
+
+// ==================== STRUCTS LOG ====================
+typedef struct {
+    char texto[TAMANHO_MENSAGEM_LOG];
+} MensagemLog;
+
+//Anel de um produtor (a simulação) e um consumidor (a thread escritora), sem travas:
+//cada índice só é alterado por um dos lados e lido pelo outro com acquire/release
+typedef struct {
+    MensagemLog* mensagens;
+    unsigned long cabeca; //Próxima mensagem a gravar (só a simulação altera)
+    unsigned long cauda; //Próxima mensagem a escrever (só a thread escritora altera)
+    int encerrar; //Pedido de parada para a thread escritora
+    int assincrono; //1 enquanto a thread escritora está rodando
+    pthread_t escritora;
+} AnelLog;
+
+extern int nivel_log;
+
+//Só chama registrar_log (e só avalia os argumentos) se o nível estiver ligado
+#define REGISTRAR_LOG(nivel, ...) do { if ((nivel) <= nivel_log) registrar_log((nivel), __VA_ARGS__); } while (0)
+
+//Nível cortado na compilação: a chamada continua checada pelo compilador, mas não gera código
+#define LOG_DESLIGADO(nivel, ...) do { if (0) registrar_log((nivel), __VA_ARGS__); } while (0)
+
+#if NIVEL_LOG_COMPILADO >= NIVEL_LOG_ERRO
+#define LOG_ERRO(...) REGISTRAR_LOG(NIVEL_LOG_ERRO, __VA_ARGS__)
+#else
+#define LOG_ERRO(...) LOG_DESLIGADO(NIVEL_LOG_ERRO, __VA_ARGS__)
+#endif
+
+#if NIVEL_LOG_COMPILADO >= NIVEL_LOG_AVISO
+#define LOG_AVISO(...) REGISTRAR_LOG(NIVEL_LOG_AVISO, __VA_ARGS__)
+#else
+#define LOG_AVISO(...) LOG_DESLIGADO(NIVEL_LOG_AVISO, __VA_ARGS__)
+#endif
+
+#if NIVEL_LOG_COMPILADO >= NIVEL_LOG_INFO
+#define LOG_INFO(...) REGISTRAR_LOG(NIVEL_LOG_INFO, __VA_ARGS__)
+#else
+#define LOG_INFO(...) LOG_DESLIGADO(NIVEL_LOG_INFO, __VA_ARGS__)
+#endif
+
+#if NIVEL_LOG_COMPILADO >= NIVEL_LOG_DEPURACAO
+#define LOG_DEPURACAO(...) REGISTRAR_LOG(NIVEL_LOG_DEPURACAO, __VA_ARGS__)
+#else
+#define LOG_DEPURACAO(...) LOG_DESLIGADO(NIVEL_LOG_DEPURACAO, __VA_ARGS__)
+#endif
+
 // ==================== STRUCTS SISTEMA PRINCIPAL ATUALIZADO====================
+typedef enum {
+    DESPACHO_FIFO, //Atende cada fila por ordem de chegada
+    DESPACHO_PRIORIDADE //Atende primeiro a maior gravidade (árvore AVL)
+} ModoDespacho;
+
 typedef struct {
     TabelaHashBairros* bairros;
     TabelaHashCidadaos* cidadaos;
-    UnidadeServico* unidades;
+    RegistroUnidades* unidades; //Frota, com bitsets de unidades livres por tipo para despacho em O(1)
+    CalendarioEventos* calendario; //Eventos futuros: chegadas, despachos, chegadas ao local, conclusões e unidades livres
     PilhaHistorico* historico_ambulancia;
     PilhaHistorico* historico_bombeiro;
     PilhaHistorico* historico_policia;
@@ -148,30 +553,62 @@ typedef struct {
     Fila* fila_ambulancia;
     Fila* fila_bombeiro;
     Fila* fila_policia;
-    ArvoreBST* arvore_ocorrencias; 
-    ArvoreAVL* arvore_prioridades;
+    IndiceOcorrencias* indice_ocorrencias; //Dono de todas as ocorrências, indexadas por ID
+    IndicePrioridades* prioridades; //Ocorrências pendentes, ordenadas por prioridade
+    ArvoreBMais* faixas_por_id; //Consultas por faixa de ID
+    ArvoreBMais* faixas_por_tempo; //Consultas por faixa de tempo de chegada
+    ArquivoOcorrencias* arquivo; //Concluídas retiradas dos índices vivos pela política de retenção
+    PainelLatencias* latencias; //Histogramas de espera e de atendimento por serviço e por bairro
+    int canceladas[NUM_TIPOS_SERVICO]; //Ocorrências canceladas antes do despacho (ex.: trotes), por serviço
     int tempo_atual;
     int proximo_id_ocorrencia;
+    ModoDespacho modo_despacho;
 } SistemaEmergencia;
 
 // ==================== FUNÇÕES HASH DOS BAIRROS ====================
 int hash_bairro(int id);
+Bairro** alocar_baldes_bairros(int capacidade);
+void migrar_baldes_bairros(TabelaHashBairros* tabela, int baldes);
+void crescer_tabela_bairros(TabelaHashBairros* tabela);
 TabelaHashBairros* criar_tabela_bairros();
 int inserir_bairro(TabelaHashBairros* tabela, int id, const char* nome);
 Bairro* buscar_bairro(TabelaHashBairros* tabela, int id);
+int listar_baldes_bairros(Bairro** baldes, int capacidade);
 void listar_bairros(TabelaHashBairros* tabela);
+int remover_bairro_balde(Bairro** balde, int id);
 int remover_bairro(TabelaHashBairros* tabela, int id);
+void liberar_baldes_bairros(Bairro** baldes, int capacidade);
 void liberar_tabela_bairros(TabelaHashBairros* tabela);
 
 // ==================== FUNÇÕES HASH DOS CIDADÃOS ====================
+int normalizar_cpf(const char* cpf, uint64_t* chave);
+void formatar_cpf(uint64_t chave, char* destino);
+uint64_t hash_chave_cpf(uint64_t chave);
 int hash_cpf(const char* cpf);
 TabelaHashCidadaos* criar_tabela_cidadaos();
 int inserir_cidadao(TabelaHashCidadaos* tabela, const char* cpf, const char* nome, 
                    const char* email, const char* endereco, int bairro_id);
+Cidadao* buscar_cidadao_chave(TabelaHashCidadaos* tabela, uint64_t chave);
 Cidadao* buscar_cidadao(TabelaHashCidadaos* tabela, const char* cpf);
 void listar_cidadaos(TabelaHashCidadaos* tabela);
 int remover_cidadao(TabelaHashCidadaos* tabela, const char* cpf);
 void liberar_tabela_cidadaos(TabelaHashCidadaos* tabela);
+#ifdef CIDADAOS_TABELA_PLANA
+EntradaIndiceCidadao* alocar_indice_cidadaos(int capacidade);
+void inserir_indice_cidadao(TabelaHashCidadaos* tabela, uint64_t chave, int registro);
+int procurar_indice_cidadao(EntradaIndiceCidadao* indice, int capacidade, uint64_t chave);
+int posicao_indice_cidadao(TabelaHashCidadaos* tabela, uint64_t chave);
+void migrar_indice_cidadaos(TabelaHashCidadaos* tabela, int entradas);
+int crescer_indice_cidadaos(TabelaHashCidadaos* tabela);
+void atualizar_registro_cidadao(TabelaHashCidadaos* tabela, uint64_t chave, int registro);
+#else
+Cidadao** alocar_baldes_cidadaos(int capacidade);
+void migrar_baldes_cidadaos(TabelaHashCidadaos* tabela, int baldes);
+void crescer_tabela_cidadaos(TabelaHashCidadaos* tabela);
+int listar_baldes_cidadaos(Cidadao** baldes, int capacidade);
+int remover_cidadao_balde(Cidadao** balde, uint64_t chave);
+void liberar_baldes_cidadaos(Cidadao** baldes, int capacidade);
+#endif
 
 // ==================== FUNÇÕES PILHA DE HISTÓRICO ====================
 PilhaHistorico* criar_pilha_historico();
@@ -184,16 +621,23 @@ void mostrar_historico(PilhaHistorico* pilha);
 void liberar_pilha_historico(PilhaHistorico* pilha);
 
 // ==================== FUNÇÕES LISTAS CRUZADAS ====================
+EntradaSlotBairro* alocar_slots_bairros(int capacidade);
+void inserir_slot_bairro(ListaCruzada* lista, int bairro_id, int slot);
+int slot_bairro_mapa(ListaCruzada* lista, int bairro_id);
+int crescer_lista_cruzada(ListaCruzada* lista);
 ListaCruzada* criar_lista_cruzada();
 int inserir_bairro_servico(ListaCruzada* lista, int bairro_id, const char* nome_bairro);
 int adicionar_servico_bairro(ListaCruzada* lista, int bairro_id, TipoServico tipo);
 int atualizar_unidades_disponiveis(ListaCruzada* lista, int bairro_id, TipoServico tipo, int delta);
+int unidades_disponiveis_bairro(ListaCruzada* lista, int bairro_id, TipoServico tipo);
+int total_unidades_disponiveis(ListaCruzada* lista, TipoServico tipo);
 void mostrar_mapa_cidade(ListaCruzada* lista);
 void liberar_lista_cruzada(ListaCruzada* lista);
 
 // ==================== FUNÇÕES ÁRVORE BST ====================
 ArvoreBST* criar_arvore_bst();
-NoArvoreBST* criar_no_bst(Ocorrencia* ocorrencia);
+Ocorrencia* ocorrencia_do_no_bst(NoArvoreBST* no);
+NoArvoreBST* iniciar_no_bst(Ocorrencia* ocorrencia);
 int inserir_bst(ArvoreBST* arvore, Ocorrencia* ocorrencia);
 NoArvoreBST* buscar_bst(ArvoreBST* arvore, int id);
 Ocorrencia* buscar_ocorrencia_por_id(ArvoreBST* arvore, int id);
@@ -202,7 +646,10 @@ void percorrer_pre_ordem_bst(NoArvoreBST* no);
 void percorrer_pos_ordem_bst(NoArvoreBST* no);
 void mostrar_arvore_bst(ArvoreBST* arvore);
 void mostrar_arvore_ordenada_por_id(ArvoreBST* arvore);
+void coletar_ocorrencias_bst(NoArvoreBST* no, Ocorrencia** vetor, int* quantidade);
+int comparar_ocorrencias_por_tempo(const void* a, const void* b);
 void mostrar_arvore_ordenada_por_tempo(ArvoreBST* arvore);
+NoArvoreBST* remover_menor_bst(NoArvoreBST* no);
 NoArvoreBST* remover_bst(NoArvoreBST* no, int id);
 int remover_ocorrencia_bst(ArvoreBST* arvore, int id);
 void liberar_arvore_bst(NoArvoreBST* no);
@@ -210,42 +657,198 @@ void liberar_bst_completa(ArvoreBST* arvore);
 
 // ==================== FUNÇÕES ÁRVORE AVL ====================
 ArvoreAVL* criar_arvore_avl();
-NoArvoreAVL* criar_no_avl(Ocorrencia* ocorrencia);
+Ocorrencia* ocorrencia_do_no_avl(NoArvoreAVL* no);
+NoArvoreAVL* iniciar_no_avl(Ocorrencia* ocorrencia);
 int altura_avl(NoArvoreAVL* no);
 int fator_balanceamento_avl(NoArvoreAVL* no);
 int max_int(int a, int b);
+int contagem_servico_avl(NoArvoreAVL* no, TipoServico tipo);
+int tamanho_subarvore_avl(NoArvoreAVL* no);
+void atualizar_no_avl(NoArvoreAVL* no);
 NoArvoreAVL* rotacao_direita(NoArvoreAVL* y);
 NoArvoreAVL* rotacao_esquerda(NoArvoreAVL* x);
 NoArvoreAVL* inserir_avl(NoArvoreAVL* no, Ocorrencia* ocorrencia);
 int inserir_avl_arvore(ArvoreAVL* arvore, Ocorrencia* ocorrencia);
 NoArvoreAVL* buscar_avl(NoArvoreAVL* no, int gravidade);
 Ocorrencia* buscar_por_gravidade(ArvoreAVL* arvore, int gravidade);
+Ocorrencia* buscar_ocorrencia_avl(ArvoreAVL* arvore, int gravidade, int id);
+Ocorrencia* maior_prioridade_servico(ArvoreAVL* arvore, TipoServico tipo);
+Ocorrencia* extrair_maior_prioridade(ArvoreAVL* arvore, TipoServico tipo);
+int comparar_prioridade_avl(int gravidade, int id, Ocorrencia* ocorrencia);
+int posicao_prioridade_avl(ArvoreAVL* arvore, int gravidade, int id);
+int contar_anteriores_avl(ArvoreAVL* arvore, int gravidade, int id);
+Ocorrencia* k_esima_prioridade_avl(ArvoreAVL* arvore, int k);
+int contar_gravidade_minima_avl(ArvoreAVL* arvore, int gravidade);
+int contar_gravidade_faixa_avl(ArvoreAVL* arvore, int gravidade_min, int gravidade_max);
 void percorrer_por_prioridade(NoArvoreAVL* no);
 void mostrar_arvore_avl(ArvoreAVL* arvore);
 void mostrar_ocorrencias_por_prioridade(ArvoreAVL* arvore);
+NoArvoreAVL* balancear_no_avl(NoArvoreAVL* no);
+NoArvoreAVL* remover_menor_avl(NoArvoreAVL* no);
 NoArvoreAVL* remover_avl(NoArvoreAVL* no, int gravidade, int id);
 int remover_ocorrencia_avl(ArvoreAVL* arvore, int gravidade, int id);
-void liberar_arvore_avl(NoArvoreAVL* no);
+int reclassificar_avl(ArvoreAVL* arvore, Ocorrencia* ocorrencia, int nova_gravidade);
 void liberar_avl_completa(ArvoreAVL* arvore);
 
+// ==================== FUNÇÕES FILA DE PRIORIDADE EM BALDES ====================
+FilaBaldes* criar_fila_baldes();
+BaldeGravidade* balde_da_ocorrencia(FilaBaldes* fila, Ocorrencia* ocorrencia);
+int esta_no_balde(BaldeGravidade* balde, Ocorrencia* ocorrencia);
+Ocorrencia* primeira_do_balde(BaldeGravidade* balde);
+int inserir_fila_baldes(FilaBaldes* fila, Ocorrencia* ocorrencia);
+int remover_fila_baldes(FilaBaldes* fila, Ocorrencia* ocorrencia);
+int reclassificar_fila_baldes(FilaBaldes* fila, Ocorrencia* ocorrencia, int nova_gravidade);
+Ocorrencia* maior_prioridade_baldes(FilaBaldes* fila, TipoServico tipo);
+Ocorrencia* extrair_maior_prioridade_baldes(FilaBaldes* fila, TipoServico tipo);
+Ocorrencia* buscar_por_gravidade_baldes(FilaBaldes* fila, int gravidade);
+int contar_gravidade_faixa_baldes(FilaBaldes* fila, int gravidade_min, int gravidade_max);
+int posicao_prioridade_baldes(FilaBaldes* fila, Ocorrencia* ocorrencia);
+void iniciar_nivel_baldes(FilaBaldes* fila, int nivel, CursorBalde* cursores);
+Ocorrencia* atual_do_cursor(CursorBalde* cursor);
+Ocorrencia* proxima_do_nivel_baldes(CursorBalde* cursores);
+Ocorrencia* k_esima_prioridade_baldes(FilaBaldes* fila, int k);
+void mostrar_fila_baldes(FilaBaldes* fila);
+void mostrar_estrutura_baldes(FilaBaldes* fila);
+void liberar_fila_baldes(FilaBaldes* fila);
+
+// ==================== FUNÇÕES ÍNDICE DE PRIORIDADES ====================
+IndicePrioridades* criar_indice_prioridades();
+int inserir_prioridade(IndicePrioridades* indice, Ocorrencia* ocorrencia);
+int remover_prioridade(IndicePrioridades* indice, Ocorrencia* ocorrencia);
+int reclassificar_prioridade(IndicePrioridades* indice, Ocorrencia* ocorrencia, int nova_gravidade);
+Ocorrencia* extrair_prioridade(IndicePrioridades* indice, TipoServico tipo);
+Ocorrencia* buscar_prioridade_por_gravidade(IndicePrioridades* indice, int gravidade);
+int posicao_prioridade(IndicePrioridades* indice, Ocorrencia* ocorrencia);
+Ocorrencia* k_esima_prioridade(IndicePrioridades* indice, int k);
+int contar_prioridades_gravidade(IndicePrioridades* indice, int gravidade_min, int gravidade_max);
+void mostrar_prioridades(IndicePrioridades* indice);
+void mostrar_estrutura_prioridades(IndicePrioridades* indice);
+const char* nome_indice_prioridades();
+const char* complexidade_indice_prioridades();
+void liberar_indice_prioridades(IndicePrioridades* indice);
+
+// ==================== FUNÇÕES ÁRVORE B+ ====================
+ArvoreBMais* criar_arvore_bmais(CriterioBMais criterio);
+NoArvoreBMais* criar_no_bmais(int folha);
+uint64_t chave_bmais(ArvoreBMais* arvore, Ocorrencia* ocorrencia);
+int posicao_filho_bmais(NoArvoreBMais* no, uint64_t chave);
+NoArvoreBMais* inserir_no_bmais(NoArvoreBMais* no, uint64_t chave, Ocorrencia* ocorrencia, uint64_t* separadora, int* inserida);
+int inserir_bmais(ArvoreBMais* arvore, Ocorrencia* ocorrencia);
+void rebalancear_filho_bmais(NoArvoreBMais* pai, int i);
+int remover_no_bmais(NoArvoreBMais* no, uint64_t chave);
+int remover_bmais(ArvoreBMais* arvore, Ocorrencia* ocorrencia);
+void iniciar_faixa_bmais(ArvoreBMais* arvore, int de, int ate, IteradorBMais* iterador);
+Ocorrencia* proxima_da_faixa_bmais(IteradorBMais* iterador);
+int mostrar_faixa_bmais(ArvoreBMais* arvore, int de, int ate);
+void liberar_no_bmais(NoArvoreBMais* no);
+void liberar_arvore_bmais(ArvoreBMais* arvore);
+
 // ==================== FUNÇÕES UNIDADES DE SERVIÇO ====================
-UnidadeServico* criar_unidade(int id, TipoServico tipo, const char* identificacao);
-int inserir_unidade(UnidadeServico** lista, int id, TipoServico tipo, const char* identificacao);
-UnidadeServico* buscar_unidade_disponivel(UnidadeServico* lista, TipoServico tipo);
-void listar_unidades(UnidadeServico* lista);
+RegistroUnidades* criar_registro_unidades();
+int crescer_registro_unidades(RegistroUnidades* registro);
+int inserir_unidade(RegistroUnidades* registro, int id, TipoServico tipo, const char* identificacao);
+int primeiro_bit(uint64_t palavra);
+int primeira_unidade_livre(RegistroUnidades* registro, TipoServico tipo);
+int ocupar_unidade_livre(RegistroUnidades* registro, TipoServico tipo);
+void devolver_unidade_livre(RegistroUnidades* registro, int unidade);
+int unidade_livre(RegistroUnidades* registro, int unidade);
+int contar_unidades_livres(RegistroUnidades* registro, TipoServico tipo);
+int contar_unidades_tipo(RegistroUnidades* registro, TipoServico tipo);
+void mostrar_resumo_frota(RegistroUnidades* registro);
 const char* tipo_servico_string(TipoServico tipo);
-void liberar_unidades(UnidadeServico* lista);
+void listar_unidades(RegistroUnidades* registro);
+void liberar_registro_unidades(RegistroUnidades* registro);
+
+// ==================== FUNÇÕES CALENDÁRIO DE EVENTOS ====================
+CalendarioEventos* criar_calendario_eventos();
+EventoSimulacao novo_evento(int tempo, TipoEvento tipo);
+int evento_antes(const EventoSimulacao* a, const EventoSimulacao* b);
+int reservar_eventos(CalendarioEventos* calendario, int quantidade);
+int agendar_evento(CalendarioEventos* calendario, EventoSimulacao evento);
+int proximo_evento(CalendarioEventos* calendario);
+EventoSimulacao retirar_evento(CalendarioEventos* calendario);
+void liberar_calendario_eventos(CalendarioEventos* calendario);
+
+// ==================== FUNÇÕES POOLS DE MEMÓRIA ====================
+extern PoolMemoria pool_ocorrencias;
+extern PoolMemoria pool_nos_bmais;
+int pool_novo_bloco(PoolMemoria* pool);
+void* pool_alocar(PoolMemoria* pool);
+void pool_liberar(PoolMemoria* pool, void* objeto);
+void pool_destruir(PoolMemoria* pool);
+void liberar_pools();
 
 // ==================== FUNÇÕES FILAS ====================
 Fila* criar_fila();
 int fila_vazia(Fila* fila);
-void enfileirar(Fila* fila, Ocorrencia* ocorrencia);
+int crescer_fila(Fila* fila);
+int enfileirar(Fila* fila, Ocorrencia* ocorrencia);
 Ocorrencia* desenfileirar(Fila* fila);
+int posicao_viva_fila(HandleOcorrencia handle, Ocorrencia* saindo);
+void podar_inicio_fila(Fila* fila, Ocorrencia* saindo);
+void compactar_fila(Fila* fila, Ocorrencia* saindo);
+void descartar_da_fila(Fila* fila, Ocorrencia* saindo);
 void mostrar_fila(Fila* fila);
 void liberar_fila(Fila* fila);
 
 // ==================== FUNÇÕES OCORRÊNCIAS ====================
 Ocorrencia* criar_ocorrencia(int id, int bairro_id, TipoServico tipo, int gravidade, int tempo);
+void liberar_ocorrencia(Ocorrencia* ocorrencia);
+HandleOcorrencia handle_ocorrencia(Ocorrencia* ocorrencia);
+Ocorrencia* resolver_handle_ocorrencia(HandleOcorrencia handle);
+void mostrar_ocorrencia(Ocorrencia* ocorrencia);
+
+// ==================== FUNÇÕES ÍNDICE DE OCORRÊNCIAS ====================
+IndiceOcorrencias* criar_indice_ocorrencias();
+int reservar_blocos_indice(IndiceOcorrencias* indice, int bloco);
+int inserir_indice_ocorrencia(IndiceOcorrencias* indice, Ocorrencia* ocorrencia);
+Ocorrencia* buscar_indice_ocorrencia(IndiceOcorrencias* indice, int id);
+int remover_indice_ocorrencia(IndiceOcorrencias* indice, int id);
+void mostrar_indice_ocorrencias(IndiceOcorrencias* indice);
+void mostrar_estrutura_indice(IndiceOcorrencias* indice);
+void liberar_indice_ocorrencias(IndiceOcorrencias* indice);
+
+// ==================== FUNÇÕES ARQUIVO DE OCORRÊNCIAS ====================
+ArquivoOcorrencias* criar_arquivo_ocorrencias();
+int crescer_concluidas(ArquivoOcorrencias* arquivo);
+int registrar_concluida(ArquivoOcorrencias* arquivo, Ocorrencia* ocorrencia);
+Ocorrencia* primeira_concluida(ArquivoOcorrencias* arquivo);
+void descartar_primeira_concluida(ArquivoOcorrencias* arquivo);
+int retencao_expirou(ArquivoOcorrencias* arquivo, Ocorrencia* ocorrencia, int tempo_atual);
+int arquivar_ocorrencia(ArquivoOcorrencias* arquivo, Ocorrencia* ocorrencia);
+OcorrenciaArquivada* buscar_arquivo_ocorrencia(ArquivoOcorrencias* arquivo, int id);
+int primeira_posicao_arquivo(ArquivoOcorrencias* arquivo, int tempo_fim);
+void mostrar_ocorrencia_arquivada(OcorrenciaArquivada* registro);
+int mostrar_faixa_arquivo(ArquivoOcorrencias* arquivo, int de, int ate);
+void mostrar_resumo_arquivo(ArquivoOcorrencias* arquivo);
+void liberar_arquivo_ocorrencias(ArquivoOcorrencias* arquivo);
+
+// ==================== FUNÇÕES HISTOGRAMAS DE LATÊNCIA ====================
+int balde_histograma(int valor);
+int maior_valor_balde_histograma(int balde);
+void registrar_histograma(HistogramaLatencia* histograma, int valor);
+int percentil_histograma(HistogramaLatencia* histograma, double percentil);
+PainelLatencias* criar_painel_latencias();
+LatenciasAtendimento* latencias_do_bairro(PainelLatencias* painel, int slot);
+void registrar_latencias(PainelLatencias* painel, TipoServico tipo, int slot_bairro, int espera);
+void registrar_duracao_atendimento(PainelLatencias* painel, TipoServico tipo, int slot_bairro, int duracao);
+void mostrar_histograma(const char* nome, HistogramaLatencia* histograma);
+void mostrar_latencias_servicos(PainelLatencias* painel);
+void mostrar_latencias_bairros(PainelLatencias* painel, ListaCruzada* mapa);
+void exportar_linha_latencias(FILE* csv, const char* escopo, int chave, const char* metrica, HistogramaLatencia* histograma);
+int exportar_latencias(PainelLatencias* painel, ListaCruzada* mapa, const char* arquivo_csv);
+void liberar_painel_latencias(PainelLatencias* painel);
+
+// ==================== FUNÇÕES LOG ====================
+void definir_nivel_log(int nivel);
+int ler_nivel_log_texto(const char* texto, int* nivel);
+const char* nivel_log_string(int nivel);
+void formatar_mensagem_log(char* destino, const char* formato, va_list argumentos);
+void registrar_log(int nivel, const char* formato, ...);
+void* escrever_log(void* argumento);
+int iniciar_log_assincrono();
+void sincronizar_log();
+void encerrar_log();
 
 // ==================== FUNÇÕES SISTEMA PRINCIPAL ====================
 SistemaEmergencia* inicializar_sistema();
@@ -253,12 +856,58 @@ void cadastrar_bairro_sistema(SistemaEmergencia* sistema, int id, const char* no
 void cadastrar_cidadao_sistema(SistemaEmergencia* sistema, const char* cpf, const char* nome,
                               const char* email, const char* endereco, int bairro_id);
 void cadastrar_unidade_sistema(SistemaEmergencia* sistema, int id, TipoServico tipo, const char* identificacao);
-void receber_ocorrencia(SistemaEmergencia* sistema, int bairro_id, TipoServico tipo, int gravidade);
+int gravidade_valida(int gravidade);
+void desfazer_recebimento(SistemaEmergencia* sistema, Ocorrencia* ocorrencia, int etapas);
+int receber_ocorrencia(SistemaEmergencia* sistema, int bairro_id, TipoServico tipo, int gravidade);
+int remover_ocorrencia_sistema(SistemaEmergencia* sistema, int id);
+int cancelar_ocorrencia(SistemaEmergencia* sistema, int id);
+int reclassificar_ocorrencia(SistemaEmergencia* sistema, int id, int nova_gravidade);
+int reclassificar_lote(SistemaEmergencia* sistema, const int* ids, const int* gravidades, int quantidade);
+int aplicar_retencao(SistemaEmergencia* sistema);
+void configurar_retencao(SistemaEmergencia* sistema, int idade_maxima, int maximo_concluidas);
+Fila* fila_do_servico(SistemaEmergencia* sistema, TipoServico tipo);
+Ocorrencia* proxima_ocorrencia(SistemaEmergencia* sistema, TipoServico tipo);
+const char* modo_despacho_string(ModoDespacho modo);
+void registrar_latencias_despacho(SistemaEmergencia* sistema, Ocorrencia* ocorrencia);
+int duracao_atendimento(TipoServico tipo);
+int deslocamento_atendimento(TipoServico tipo);
+const char* observacao_atendimento(TipoServico tipo);
+const char* nome_unidade_servico(TipoServico tipo);
+int agendar_despacho(SistemaEmergencia* sistema, TipoServico tipo, int tempo);
+int despachar_ocorrencia(SistemaEmergencia* sistema, TipoServico tipo);
 void processar_atendimentos(SistemaEmergencia* sistema);
+void concluir_atendimento(SistemaEmergencia* sistema, EventoSimulacao evento);
+void devolver_unidade(SistemaEmergencia* sistema, EventoSimulacao evento);
+void tratar_evento(SistemaEmergencia* sistema, EventoSimulacao evento);
+int agendar_ocorrencia(SistemaEmergencia* sistema, int tempo, int bairro_id, TipoServico tipo, int gravidade);
+uint64_t proximo_aleatorio_trafego(uint64_t* estado);
+int gerar_trafego(SistemaEmergencia* sistema, int chamadas, int duracao, uint64_t semente);
 void simular_tempo(SistemaEmergencia* sistema, int unidades_tempo);
 void status_sistema(SistemaEmergencia* sistema);
 void liberar_sistema(SistemaEmergencia* sistema);
 
+// ==================== FUNÇÕES BENCHMARK DAS ÁRVORES ====================
+extern long long comparacoes_arvores;
+uint64_t proximo_aleatorio_benchmark(uint64_t* estado);
+int comparar_id_contando(int id, NoArvoreBST* no);
+int comparar_prioridade_contando(int gravidade, int id, NoArvoreAVL* no);
+void contar_caminho_bst(ArvoreBST* arvore, int id);
+void contar_caminho_avl(ArvoreAVL* arvore, int gravidade, int id);
+int comparar_tempos(const void* a, const void* b);
+const char* estrutura_benchmark_string(EstruturaBenchmark estrutura);
+const char* operacao_benchmark_string(OperacaoBenchmark operacao);
+void executar_operacao_benchmark(EstruturasBenchmark* estruturas, EstruturaBenchmark estrutura,
+                                 OperacaoBenchmark operacao, Ocorrencia* alvo, int contar);
+void medir_operacoes_benchmark(EstruturasBenchmark* estruturas, EstruturaBenchmark estrutura,
+                               OperacaoBenchmark operacao, Ocorrencia** alvos, long quantidade,
+                               int contar, double* amostras, ResultadoBenchmark* resultado);
+void registrar_resultado_benchmark(ResultadoBenchmark* resultado, FILE* tabela, FILE* csv);
+int executar_passada_benchmark(EstruturaBenchmark estrutura, long n, long operacoes, int contar,
+                               EstruturasBenchmark* estruturas, Ocorrencia** alvos, double* amostras,
+                               ResultadoBenchmark* resultados);
+int executar_benchmark_arvores(long n, long m, FILE* tabela, FILE* csv);
+int benchmark_arvores(long n, long m, const char* arquivo_csv, FILE* saida);
+
 // ==================== FUNÇÕES INTERFACE ====================
 void exibir_menu_principal();
 void menu_configuracao(SistemaEmergencia* sistema);
@@ -274,4 +923,17 @@ void ler_string(const char* mensagem, char* destino, int tamanho);
 TipoServico escolher_tipo_servico();
 void pausar_sistema();
 
+// ==================== FUNÇÕES MODO LOTE ====================
+double tempo_em_segundos();
+char* aparar_texto(char* texto);
+int separar_campos(char* linha, char* campos[], int max_campos);
+int ler_inteiro_texto(const char* texto, int* valor);
+int ler_campo_semente(char* campos[], int campo, uint64_t* semente, int* numero_invalido);
+int ler_campos_inteiros(char* campos[], int primeiro, int ultimo, int* valores, int* numero_invalido);
+int ler_tipo_servico_texto(const char* texto, TipoServico* tipo);
+PilhaHistorico* historico_do_servico(SistemaEmergencia* sistema, TipoServico tipo);
+int executar_comando_lote(SistemaEmergencia* sistema, char* linha);
+int linha_lote_completa(char* linha, FILE* entrada);
+long executar_lote(SistemaEmergencia* sistema, FILE* entrada);
+
 #endif
\ No newline at end of file
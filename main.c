@@ -1,6 +1,6 @@
 #include "emergencia.h"
 
-int main() {
+int main(int argc, char* argv[]) {
     //Aqui inicializamos o sistema, se ele não inicializar retornamos um erro
     SistemaEmergencia* sistema = inicializar_sistema();
     if (!sistema) {
@@ -8,6 +8,25 @@ int main() {
         return 1;
     }
     
+    //Modo lote: executa um roteiro de comandos (arquivo ou entrada padrão) sem menus
+    if (argc > 1 && strcmp(argv[1], "--lote") == 0) {
+        FILE* entrada = stdin;
+        if (argc > 2 && strcmp(argv[2], "-") != 0) {
+            entrada = fopen(argv[2], "r");
+            if (!entrada) {
+                printf("Erro ao abrir o roteiro %s\n", argv[2]);
+                liberar_sistema(sistema);
+                return 1;
+            }
+        }
+        
+        executar_lote(sistema, entrada);
+        
+        if (entrada != stdin) fclose(entrada);
+        liberar_sistema(sistema);
+        return 0;
+    }
+    
     printf("=== SIMULADOR DE EMERGENCIA URBANA ===\n");
     printf("Sistema inicializado com sucesso!\n");
     
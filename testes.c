@@ -0,0 +1,305 @@
+#include "emergencia.h"
+
+//Testes de regressão das estruturas de emergencia.c, com verificações por asserção
+//Compile com "make test", que roda duas variantes: a padrão (tabela encadeada e AVL) e
+//a de -DCIDADAOS_TABELA_PLANA -DPRIORIDADES_BALDES (índice plano e fila de baldes)
+//
+//Cada verificação que falha é informada com arquivo e linha; o código de saída é 1 se alguma falhou
+
+#define CIDADAOS_TESTE 5000 //Cidadãos inseridos no teste da tabela (várias duplicações do índice)
+#define CPF_BASE_TESTE 12345678900ULL //Primeira chave de CPF do teste (11 dígitos)
+#define PASSO_CPF_TESTE 7919ULL //Distância entre as chaves, para espalhar os CPFs
+#define SEMENTE_TESTE 88172645463325252ULL //Semente fixa, para execuções repetíveis
+
+#ifdef CIDADAOS_TABELA_PLANA
+#define BACKEND_CIDADAOS_TESTE "plana"
+#else
+#define BACKEND_CIDADAOS_TESTE "encadeada"
+#endif
+
+int verificacoes = 0;
+int falhas = 0;
+
+//Registra uma verificação e informa onde ela falhou
+void verificar(int condicao, const char* texto, const char* arquivo, int linha) {
+    verificacoes++;
+    if (!condicao) {
+        falhas++;
+        fprintf(stderr, "%s:%d: falhou: %s\n", arquivo, linha, texto);
+    }
+}
+
+#define VERIFICAR(condicao) verificar((condicao) != 0, #condicao, __FILE__, __LINE__)
+
+// ==================== TABELA DE CIDADÃOS ====================
+
+//Escreve o CPF do i-ésimo cidadão do teste
+void cpf_teste(int i, char* destino) {
+    formatar_cpf(CPF_BASE_TESTE + (uint64_t)i * PASSO_CPF_TESTE, destino);
+}
+
+//Retorna 1 se a tabela está no meio de um rehash incremental
+int tabela_migrando(TabelaHashCidadaos* tabela) {
+#ifdef CIDADAOS_TABELA_PLANA
+    return tabela->indice_antigo != NULL;
+#else
+    return tabela->tabela_antiga != NULL;
+#endif
+}
+
+//Conta as lápides do índice antigo (só existem no índice plano, durante a migração)
+int lapides_cidadaos(TabelaHashCidadaos* tabela) {
+    int lapides = 0;
+#ifdef CIDADAOS_TABELA_PLANA
+    for (int i = 0; tabela->indice_antigo && i < tabela->capacidade_antiga; i++) {
+        if (tabela->indice_antigo[i].registro == ENTRADA_CIDADAO_REMOVIDA) lapides++;
+    }
+#else
+    (void)tabela;
+#endif
+    return lapides;
+}
+
+//Insere e remove cidadãos misturados, inclusive durante as migrações, e confere cada CPF
+//contra um vetor de presença. No índice plano, confere também que as remoções no meio da
+//migração deixam lápides no índice antigo e que elas não voltam a valer depois
+void testar_tabela_cidadaos() {
+    TabelaHashCidadaos* tabela = criar_tabela_cidadaos();
+    char* presente = (char*)calloc(CIDADAOS_TESTE, 1);
+    VERIFICAR(tabela && presente);
+    if (!tabela || !presente) return;
+
+    uint64_t estado = SEMENTE_TESTE;
+    char cpf[MAX_CPF];
+    int presentes = 0;
+    int remocoes_migrando = 0;
+    int maximo_lapides = 0;
+
+    for (int i = 0; i < CIDADAOS_TESTE; i++) {
+        cpf_teste(i, cpf);
+        VERIFICAR(inserir_cidadao(tabela, cpf, "Cidadao", "c@teste", "Rua", i));
+        presente[i] = 1;
+        presentes++;
+
+        //Remove um cidadão sorteado a cada três inserções, muitas vezes no meio de uma migração
+        if (i % 3 == 2) {
+            int alvo = (int)(proximo_aleatorio_benchmark(&estado) % (uint64_t)(i + 1));
+            int migrando = tabela_migrando(tabela);
+            cpf_teste(alvo, cpf);
+            VERIFICAR(remover_cidadao(tabela, cpf) == presente[alvo]);
+            if (presente[alvo]) {
+                presentes--;
+                remocoes_migrando += migrando;
+            }
+            presente[alvo] = 0;
+
+            int lapides = lapides_cidadaos(tabela);
+            if (lapides > maximo_lapides) maximo_lapides = lapides;
+        }
+    }
+
+    VERIFICAR(remocoes_migrando > 0);
+#ifdef CIDADAOS_TABELA_PLANA
+    VERIFICAR(maximo_lapides > 0);
+#endif
+
+    //Cada CPF é achado se e só se está presente, e o registro achado é o dele
+    for (int i = 0; i < CIDADAOS_TESTE; i++) {
+        cpf_teste(i, cpf);
+        Cidadao* cidadao = buscar_cidadao(tabela, cpf);
+        VERIFICAR((cidadao != NULL) == presente[i]);
+        if (cidadao) VERIFICAR(cidadao->bairro_id == i);
+    }
+    VERIFICAR(tabela->quantidade == presentes);
+
+    //As buscas acima terminam a migração; reinserir um removido não pode achar a lápide
+    VERIFICAR(!tabela_migrando(tabela));
+    for (int i = 0; i < CIDADAOS_TESTE; i++) {
+        if (presente[i]) continue;
+        cpf_teste(i, cpf);
+        VERIFICAR(inserir_cidadao(tabela, cpf, "Cidadao", "c@teste", "Rua", -i));
+        VERIFICAR(buscar_cidadao(tabela, cpf) && buscar_cidadao(tabela, cpf)->bairro_id == -i);
+        break;
+    }
+
+    free(presente);
+    liberar_tabela_cidadaos(tabela);
+}
+
+// ==================== PRIORIDADES: CANCELAR, RECLASSIFICAR E POSIÇÃO ====================
+
+//Cria um sistema silencioso com um bairro que oferece os três serviços
+SistemaEmergencia* criar_sistema_teste() {
+    SistemaEmergencia* sistema = inicializar_sistema();
+    cadastrar_bairro_sistema(sistema, 1, "Centro");
+    for (int t = 0; t < NUM_TIPOS_SERVICO; t++) {
+        adicionar_servico_bairro(sistema->mapa_cidade, 1, (TipoServico)t);
+    }
+    return sistema;
+}
+
+//Confere a posição de cada ID esperado na ordem de prioridade e a k-ésima de cada posição
+void verificar_ordem_prioridade(SistemaEmergencia* sistema, const int* ids, int quantidade) {
+    VERIFICAR(sistema->prioridades->tamanho == quantidade);
+    for (int i = 0; i < quantidade; i++) {
+        Ocorrencia* ocorrencia = buscar_indice_ocorrencia(sistema->indice_ocorrencias, ids[i]);
+        VERIFICAR(posicao_prioridade(sistema->prioridades, ocorrencia) == i + 1);
+
+        Ocorrencia* k_esima = k_esima_prioridade(sistema->prioridades, i + 1);
+        VERIFICAR(k_esima && k_esima->id == ids[i]);
+    }
+    VERIFICAR(k_esima_prioridade(sistema->prioridades, quantidade + 1) == NULL);
+}
+
+//Sem unidades de ambulância, as ocorrências ficam pendentes e a ordem é (gravidade desc, ID asc)
+//Na fila de baldes, reclassificar um ID antigo para um balde com IDs mais novos usa a AVL do balde
+void testar_prioridades() {
+    SistemaEmergencia* sistema = criar_sistema_teste();
+    int gravidades[] = { 1, 2, 3, 1, 2, 3 };
+    for (int i = 0; i < 6; i++) {
+        VERIFICAR(receber_ocorrencia(sistema, 1, AMBULANCIA, gravidades[i]));
+    }
+
+    int ordem_inicial[] = { 3, 6, 2, 5, 1, 4 };
+    verificar_ordem_prioridade(sistema, ordem_inicial, 6);
+    VERIFICAR(contar_prioridades_gravidade(sistema->prioridades, 2, 3) == 4);
+
+    //A ocorrência #1 sobe para a gravidade 3, antes das mais novas #3 e #6
+    VERIFICAR(reclassificar_ocorrencia(sistema, 1, 3) == 1);
+    int ordem_reclassificada[] = { 1, 3, 6, 2, 5, 4 };
+    verificar_ordem_prioridade(sistema, ordem_reclassificada, 6);
+
+    VERIFICAR(cancelar_ocorrencia(sistema, 3) == 1);
+    VERIFICAR(cancelar_ocorrencia(sistema, 3) == 0);
+    VERIFICAR(buscar_indice_ocorrencia(sistema->indice_ocorrencias, 3) == NULL);
+    VERIFICAR(fila_do_servico(sistema, AMBULANCIA)->tamanho == 5);
+
+    //A #6 desce para a gravidade 1, depois da #4, que é mais antiga
+    VERIFICAR(reclassificar_ocorrencia(sistema, 6, 1) == 1);
+    int ordem_final[] = { 1, 2, 5, 4, 6 };
+    verificar_ordem_prioridade(sistema, ordem_final, 5);
+
+    VERIFICAR(reclassificar_ocorrencia(sistema, 2, NIVEIS_GRAVIDADE + 1) == -1);
+    VERIFICAR(reclassificar_ocorrencia(sistema, 99, 1) == 0);
+
+    //Uma ocorrência já despachada não pode ser cancelada nem reclassificada
+    cadastrar_unidade_sistema(sistema, 1, POLICIA, "POL-01");
+    VERIFICAR(receber_ocorrencia(sistema, 1, POLICIA, 2));
+    int policial = sistema->proximo_id_ocorrencia - 1;
+    simular_tempo(sistema, ATRASO_DESPACHO);
+    VERIFICAR(cancelar_ocorrencia(sistema, policial) == -1);
+    VERIFICAR(reclassificar_ocorrencia(sistema, policial, 3) == -1);
+    verificar_ordem_prioridade(sistema, ordem_final, 5);
+
+    //A fila FIFO continua coerente com as lápides deixadas pelo cancelamento
+    sistema->modo_despacho = DESPACHO_FIFO;
+    cadastrar_unidade_sistema(sistema, 2, AMBULANCIA, "AMB-01");
+    Ocorrencia* primeira = proxima_ocorrencia(sistema, AMBULANCIA);
+    VERIFICAR(primeira && primeira->id == 1);
+
+    liberar_sistema(sistema);
+}
+
+// ==================== HANDLES DEPOIS DA RETENÇÃO ====================
+
+//Ocorrências concluídas e arquivadas pela retenção saem dos índices; os handles que
+//apontavam para elas deixam de valer mesmo que o pool reaproveite a memória
+void testar_handles_retencao() {
+    SistemaEmergencia* sistema = criar_sistema_teste();
+    cadastrar_unidade_sistema(sistema, 1, POLICIA, "POL-01");
+
+    VERIFICAR(receber_ocorrencia(sistema, 1, POLICIA, 3));
+    VERIFICAR(receber_ocorrencia(sistema, 1, POLICIA, 2));
+    HandleOcorrencia handles[2];
+    for (int i = 0; i < 2; i++) {
+        handles[i] = handle_ocorrencia(buscar_indice_ocorrencia(sistema->indice_ocorrencias, i + 1));
+        VERIFICAR(resolver_handle_ocorrencia(handles[i]) != NULL);
+    }
+
+    //Uma unidade atende as duas em sequência; depois disso ambas estão concluídas
+    simular_tempo(sistema, ATRASO_DESPACHO + 2 * (DURACAO_POLICIA + TEMPO_RETORNO) + 1);
+    for (int i = 0; i < 2; i++) {
+        Ocorrencia* ocorrencia = resolver_handle_ocorrencia(handles[i]);
+        VERIFICAR(ocorrencia && ocorrencia->estado == OCORRENCIA_CONCLUIDA);
+    }
+
+    configurar_retencao(sistema, RETENCAO_DESLIGADA, 0);
+    for (int i = 0; i < 2; i++) {
+        VERIFICAR(resolver_handle_ocorrencia(handles[i]) == NULL);
+        VERIFICAR(buscar_indice_ocorrencia(sistema->indice_ocorrencias, i + 1) == NULL);
+        VERIFICAR(buscar_arquivo_ocorrencia(sistema->arquivo, i + 1) != NULL);
+    }
+    VERIFICAR(sistema->arquivo->concluidas_vivas == 0);
+
+    //A próxima ocorrência pode ocupar a mesma memória; o handle antigo continua inválido
+    VERIFICAR(receber_ocorrencia(sistema, 1, BOMBEIRO, 1));
+    Ocorrencia* nova = buscar_indice_ocorrencia(sistema->indice_ocorrencias, 3);
+    VERIFICAR(nova != NULL);
+    for (int i = 0; i < 2; i++) {
+        VERIFICAR(resolver_handle_ocorrencia(handles[i]) == NULL);
+    }
+    VERIFICAR(resolver_handle_ocorrencia(handle_ocorrencia(nova)) == nova);
+
+    liberar_sistema(sistema);
+}
+
+// ==================== CONTADORES DO MAPA ====================
+
+//Confere que nenhum contador do mapa está negativo
+void verificar_mapa_nao_negativo(ListaCruzada* mapa) {
+    for (int t = 0; t < NUM_TIPOS_SERVICO; t++) {
+        for (int slot = 0; slot < mapa->quantidade; slot++) {
+            VERIFICAR(mapa->disponiveis[t][slot] >= 0);
+        }
+    }
+}
+
+//Despacha mais chamados em um bairro do que ele tem unidades no mapa e, quando toda a frota
+//volta, os contadores de cada bairro são de novo os iniciais
+void testar_contadores_mapa() {
+    SistemaEmergencia* sistema = inicializar_sistema();
+    cadastrar_bairro_sistema(sistema, 1, "Centro");
+    cadastrar_bairro_sistema(sistema, 2, "Jardim");
+    adicionar_servico_bairro(sistema->mapa_cidade, 1, AMBULANCIA);
+    adicionar_servico_bairro(sistema->mapa_cidade, 2, AMBULANCIA);
+    adicionar_servico_bairro(sistema->mapa_cidade, 2, AMBULANCIA);
+    for (int u = 1; u <= 3; u++) {
+        cadastrar_unidade_sistema(sistema, u, AMBULANCIA, "AMB");
+    }
+
+    int iniciais[] = { unidades_disponiveis_bairro(sistema->mapa_cidade, 1, AMBULANCIA),
+                       unidades_disponiveis_bairro(sistema->mapa_cidade, 2, AMBULANCIA) };
+    VERIFICAR(iniciais[0] == 1 && iniciais[1] == 2);
+
+    for (int i = 0; i < 5; i++) {
+        VERIFICAR(receber_ocorrencia(sistema, 1, AMBULANCIA, 1 + i % NIVEIS_GRAVIDADE));
+    }
+    VERIFICAR(receber_ocorrencia(sistema, 2, AMBULANCIA, 2));
+
+    for (int tempo = 0; tempo < 20; tempo++) {
+        simular_tempo(sistema, 1);
+        verificar_mapa_nao_negativo(sistema->mapa_cidade);
+    }
+
+    VERIFICAR(fila_vazia(fila_do_servico(sistema, AMBULANCIA)));
+    VERIFICAR(contar_unidades_livres(sistema->unidades, AMBULANCIA) == 3);
+    VERIFICAR(unidades_disponiveis_bairro(sistema->mapa_cidade, 1, AMBULANCIA) == iniciais[0]);
+    VERIFICAR(unidades_disponiveis_bairro(sistema->mapa_cidade, 2, AMBULANCIA) == iniciais[1]);
+    VERIFICAR(total_unidades_disponiveis(sistema->mapa_cidade, AMBULANCIA) == iniciais[0] + iniciais[1]);
+
+    liberar_sistema(sistema);
+}
+
+int main() {
+    //As mensagens do sistema não interessam aos testes
+    definir_nivel_log(NIVEL_LOG_SILENCIOSO);
+
+    testar_tabela_cidadaos();
+    testar_prioridades();
+    testar_handles_retencao();
+    testar_contadores_mapa();
+
+    printf("Testes (cidadãos %s, prioridades %s): %d verificações, %d falhas\n",
+           BACKEND_CIDADAOS_TESTE, nome_indice_prioridades(), verificacoes, falhas);
+    return falhas ? 1 : 0;
+}